@@ -0,0 +1,131 @@
+#include "gorilla/common/gc_common.h"
+#include "gorilla/common/gc_thread.h"
+
+#include <stdio.h>
+
+/* Stress test for the lock-free gc_CircBuffer: one thread pushes a numbered
+   byte sequence in odd-sized chunks, another pulls it out in different
+   odd-sized chunks and checks that no byte is lost, repeated or reordered.
+   Chunk sizes never divide the buffer size, so spans constantly wrap. */
+
+#define NUM_BYTES (16 * 1024 * 1024)
+#define SEQUENCE_PERIOD 251 /* Prime, so the pattern never lines up with the wrap */
+
+typedef struct RingTest {
+  gc_CircBuffer* buffer;
+  gc_uint32 maxChunk;
+  volatile gc_int32 producerDone;
+  gc_int32 numErrors;
+} RingTest;
+
+static gc_uint32 nextChunk(gc_uint32* in_state, gc_uint32 in_maxChunk)
+{
+  *in_state = *in_state * 1103515245u + 12345u;
+  return 1 + ((*in_state >> 16) % in_maxChunk);
+}
+static gc_int32 producerFunc(void* in_context)
+{
+  RingTest* test = (RingTest*)in_context;
+  gc_uint32 state = 1;
+  gc_uint32 sent = 0;
+  while(sent < NUM_BYTES)
+  {
+    void* data[2];
+    gc_uint32 size[2];
+    gc_uint32 chunk = nextChunk(&state, test->maxChunk);
+    gc_int32 numSpans;
+    gc_int32 i;
+    gc_uint32 j;
+    chunk = chunk < NUM_BYTES - sent ? chunk : NUM_BYTES - sent;
+    numSpans = gc_buffer_getFree(test->buffer, chunk, &data[0], &size[0], &data[1], &size[1]);
+    if(numSpans < 0)
+    {
+      gc_thread_sleep(0); /* Full; let the consumer catch up */
+      continue;
+    }
+    for(i = 0; i < numSpans; ++i)
+    {
+      for(j = 0; j < size[i]; ++j)
+        ((gc_uint8*)data[i])[j] = (gc_uint8)(sent++ % SEQUENCE_PERIOD);
+    }
+    gc_buffer_produce(test->buffer, chunk);
+  }
+  gc_atomic_store(&test->producerDone, 1);
+  return 0;
+}
+static gc_int32 consumerFunc(void* in_context)
+{
+  RingTest* test = (RingTest*)in_context;
+  gc_uint32 state = 7;
+  gc_uint32 received = 0;
+  while(received < NUM_BYTES)
+  {
+    void* data[2];
+    gc_uint32 size[2];
+    gc_uint32 chunk = nextChunk(&state, test->maxChunk);
+    gc_int32 done = gc_atomic_load(&test->producerDone);
+    gc_uint32 avail = gc_buffer_bytesAvail(test->buffer);
+    gc_int32 numSpans;
+    gc_int32 i;
+    gc_uint32 j;
+    chunk = chunk < avail ? chunk : avail;
+    if(!chunk && done)
+      break; /* Everything the producer sent has been seen */
+    if(!chunk)
+    {
+      gc_thread_sleep(0); /* Empty; let the producer catch up */
+      continue;
+    }
+    numSpans = gc_buffer_getAvail(test->buffer, chunk, &data[0], &size[0], &data[1], &size[1]);
+    for(i = 0; i < numSpans; ++i)
+    {
+      for(j = 0; j < size[i]; ++j)
+      {
+        if(((gc_uint8*)data[i])[j] != (gc_uint8)(received % SEQUENCE_PERIOD) && test->numErrors++ < 10)
+          printf("  byte %u: got %d, expected %d\n", received,
+                 ((gc_uint8*)data[i])[j], (gc_int32)(received % SEQUENCE_PERIOD));
+        ++received;
+      }
+    }
+    gc_buffer_consume(test->buffer, chunk);
+  }
+  if(received != NUM_BYTES)
+  {
+    printf("  received %u bytes, expected %u\n", received, (gc_uint32)NUM_BYTES);
+    ++test->numErrors;
+  }
+  return 0;
+}
+static gc_int32 runTest(const char* in_name, gc_CircBuffer* in_buffer)
+{
+  RingTest test;
+  gc_Thread* producer;
+  gc_Thread* consumer;
+  test.buffer = in_buffer;
+  test.maxChunk = in_buffer->dataSize / 3 - 1; /* Several chunks in flight */
+  test.producerDone = 0;
+  test.numErrors = 0;
+  producer = gc_thread_create(producerFunc, &test, GC_THREAD_PRIORITY_NORMAL, 0);
+  consumer = gc_thread_create(consumerFunc, &test, GC_THREAD_PRIORITY_NORMAL, 0);
+  gc_thread_run(producer);
+  gc_thread_run(consumer);
+  gc_thread_join(producer);
+  gc_thread_join(consumer);
+  gc_thread_destroy(producer);
+  gc_thread_destroy(consumer);
+  printf("%s (%u bytes%s): %d bytes sent, %d errors\n", in_name, in_buffer->dataSize,
+         in_buffer->mirrored ? ", mirrored" : "", NUM_BYTES, test.numErrors);
+  gc_buffer_destroy(in_buffer);
+  return test.numErrors;
+}
+int main(int argc, char** argv)
+{
+  gc_int32 numErrors = 0;
+  gc_initialize(0);
+  numErrors += runTest("small", gc_buffer_create(256));
+  numErrors += runTest("regular", gc_buffer_create(4096));
+  numErrors += runTest("mirrored", gc_buffer_create_mirrored(65536));
+  gc_shutdown();
+  printf(numErrors ? "FAILED\n" : "PASSED\n");
+  return numErrors ? 1 : 0;
+}
@@ -0,0 +1,247 @@
+#include "gorilla/ga.h"
+#include "gorilla/gau.h"
+#include "gorilla/common/gc_thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Stress test for ga_BufferedStream seeking: one thread hammers the stream
+   with seeks (some close enough to be served from buffered data, some not)
+   while another reads from it and stream threads refill it. Every frame of
+   the source stores its own position, so the reader can check that playback
+   only ever jumps to a position that was actually requested. Each round
+   also scrubs backwards in short steps, which together reach further back
+   than the buffer's history window, and ends with a seek to a marker position no other seek uses, and the round
+   passes once the reader lands on it and ga_stream_tell64() agrees. */
+
+#define NUM_FRAMES (1 << 21)
+#define NUM_ROUNDS 200
+#define SEEKS_PER_ROUND 64
+#define SCRUBS_PER_ROUND 8
+#define SCRUB_FRAMES (BUFFER_FRAMES / 32 + 1) /* The history window holds BUFFER_FRAMES / 8 */
+#define NUM_STREAM_THREADS 2
+#define BUFFER_FRAMES 16384
+#define READ_FRAMES 333 /* Doesn't divide the buffer, so reads straddle the wrap */
+#define MARKER_RANGE (NUM_FRAMES / 2) /* Markers are odd, below this; other seeks are even */
+#define TIMEOUT_NS 5000000000ull
+
+typedef struct SeekTest {
+  ga_StreamManager* mgr;
+  ga_BufferedStream* stream;
+  gc_int64* targets; /* Every target requested so far */
+  volatile gc_int32 numTargets;
+  volatile gc_int32 marker; /* Latest marker target; -1 before the first */
+  volatile gc_int32 landed; /* Latest marker the reader has landed on */
+  volatile gc_int32 stopStreaming;
+  volatile gc_int32 stopReading;
+  volatile gc_int32 slowReading; /* Read a frame at a time, so the buffer stays full */
+  gc_int64 nextFrame; /* Reader's next expected frame, once it has stopped */
+  gc_int32 numErrors;
+} SeekTest;
+
+static gc_uint32 nextRandom(gc_uint32* in_state)
+{
+  *in_state = *in_state * 1103515245u + 12345u;
+  return *in_state >> 8;
+}
+static void fail(SeekTest* in_test, const char* in_what, gc_int64 in_a, gc_int64 in_b)
+{
+  if(in_test->numErrors++ < 10)
+    printf("  %s: %d, %d\n", in_what, (gc_int32)in_a, (gc_int32)in_b);
+}
+static gc_int32 streamFunc(void* in_context)
+{
+  SeekTest* test = (SeekTest*)in_context;
+  while(!gc_atomic_load(&test->stopStreaming))
+  {
+    ga_stream_manager_buffer(test->mgr);
+    ga_stream_manager_wait(test->mgr, 5);
+  }
+  return 0;
+}
+static gc_int32 requested(SeekTest* in_test, gc_int64 in_frame)
+{
+  gc_int32 n = gc_atomic_load(&in_test->numTargets);
+  gc_int32 i;
+  for(i = n - 1; i >= 0; --i)
+  {
+    if(in_test->targets[i] == in_frame)
+      return 1;
+  }
+  return 0;
+}
+static gc_int32 readerFunc(void* in_context)
+{
+  SeekTest* test = (SeekTest*)in_context;
+  gc_int16 frames[READ_FRAMES * 2];
+  gc_int64 prev = -1;
+  while(!gc_atomic_load(&test->stopReading))
+  {
+    gc_int32 slow = gc_atomic_load(&test->slowReading);
+    gc_int32 numRead = ga_stream_read(test->stream, frames, slow ? 1 : READ_FRAMES);
+    gc_int32 i;
+    if(slow)
+      gc_thread_sleep(1);
+    else if(!numRead)
+      gc_thread_sleep(0); /* Starved or seeking; let the stream threads run */
+    for(i = 0; i < numRead; ++i)
+    {
+      gc_int64 frame = (gc_uint16)frames[i * 2] | ((gc_int64)(gc_uint16)frames[i * 2 + 1] << 16);
+      if(frame != prev + 1)
+      {
+        /* A jump must land on a requested target */
+        if(!requested(test, frame))
+          fail(test, "jumped to an unrequested frame (from, to)", prev, frame);
+        else if((frame & 1) && frame < MARKER_RANGE && frame != gc_atomic_load(&test->marker))
+          fail(test, "landed on a stale marker (got, expected)", frame, gc_atomic_load(&test->marker));
+      }
+      if(frame == gc_atomic_load(&test->marker))
+        gc_atomic_store(&test->landed, (gc_int32)frame);
+      prev = frame;
+    }
+  }
+  test->nextFrame = prev + 1;
+  return 0;
+}
+static void requestSeek(SeekTest* in_test, gc_int64 in_target)
+{
+  /* Only markers may be odd below MARKER_RANGE */
+  if(in_target != gc_atomic_load(&in_test->marker))
+  {
+    in_target = in_target < 0 ? 0 : in_target;
+    in_target = in_target < NUM_FRAMES - BUFFER_FRAMES ? in_target : NUM_FRAMES - BUFFER_FRAMES;
+    in_target = in_target < MARKER_RANGE ? in_target & ~(gc_int64)1 : in_target;
+  }
+  in_test->targets[in_test->numTargets] = in_target;
+  gc_atomic_add(&in_test->numTargets, 1); /* Published before the seek */
+  ga_stream_seek64(in_test->stream, in_target);
+}
+static void runRounds(SeekTest* in_test)
+{
+  gc_uint32 state = 1;
+  gc_int32 round;
+  for(round = 0; round < NUM_ROUNDS && !in_test->numErrors; ++round)
+  {
+    gc_int64 marker;
+    gc_uint64 start;
+    gc_int32 i;
+    for(i = 0; i < SEEKS_PER_ROUND; ++i)
+    {
+      /* Half near the current position (usually soft), half anywhere */
+      gc_int64 target;
+      if(nextRandom(&state) & 1)
+        target = ga_stream_tell64(in_test->stream, 0) + (gc_int32)(nextRandom(&state) % (BUFFER_FRAMES * 2)) - BUFFER_FRAMES / 2;
+      else
+        target = nextRandom(&state) % NUM_FRAMES;
+      requestSeek(in_test, target);
+      if(nextRandom(&state) & 1)
+        gc_thread_sleep(0);
+    }
+    /* Backward steps from a full buffer, each seen by a read before the next */
+    gc_atomic_store(&in_test->slowReading, 1);
+    gc_thread_sleep(10);
+    for(i = 0; i < SCRUBS_PER_ROUND; ++i)
+    {
+      requestSeek(in_test, ga_stream_tell64(in_test->stream, 0) - SCRUB_FRAMES);
+      gc_thread_sleep(3);
+    }
+    gc_atomic_store(&in_test->slowReading, 0);
+    /* A marker right after a near seek, to race with its fallback */
+    requestSeek(in_test, ga_stream_tell64(in_test->stream, 0) + BUFFER_FRAMES - 1);
+    do
+      marker = (nextRandom(&state) % (MARKER_RANGE / 2)) * 2 + 1;
+    while(requested(in_test, marker));
+    gc_atomic_store(&in_test->marker, (gc_int32)marker);
+    requestSeek(in_test, marker);
+    start = gc_time_ns();
+    while(gc_atomic_load(&in_test->landed) != marker)
+    {
+      gc_int64 tell = ga_stream_tell64(in_test->stream, 0);
+      if(tell < marker || tell > NUM_FRAMES)
+      {
+        fail(in_test, "tell position diverged from the marker (tell, marker)", tell, marker);
+        break;
+      }
+      if(gc_time_ns() - start > TIMEOUT_NS)
+      {
+        fail(in_test, "never landed on the marker (tell, marker)", tell, marker);
+        break;
+      }
+      gc_thread_sleep(0);
+    }
+  }
+  printf("%d rounds, %d seeks\n", round, in_test->numTargets);
+}
+int main(int argc, char** argv)
+{
+  SeekTest test;
+  ga_Format format;
+  gc_int16* pcm;
+  ga_Memory* memory;
+  ga_Sound* sound;
+  ga_SampleSource* src;
+  gc_Thread* streamThreads[NUM_STREAM_THREADS];
+  gc_Thread* reader;
+  gc_int32 i;
+  gc_initialize(0);
+
+  /* Stereo 16-bit source whose frames hold their own position */
+  format.sampleRate = 44100;
+  format.bitsPerSample = 16;
+  format.numChannels = 2;
+  pcm = (gc_int16*)malloc(NUM_FRAMES * 2 * sizeof(gc_int16));
+  for(i = 0; i < NUM_FRAMES; ++i)
+  {
+    pcm[i * 2] = (gc_int16)(i & 0xffff);
+    pcm[i * 2 + 1] = (gc_int16)(i >> 16);
+  }
+  memory = ga_memory_create(pcm, NUM_FRAMES * 2 * sizeof(gc_int16));
+  free(pcm);
+  sound = ga_sound_create(memory, &format);
+  ga_memory_release(memory);
+  src = gau_sample_source_create_sound(sound);
+  ga_sound_release(sound);
+
+  test.mgr = ga_stream_manager_create();
+  test.stream = ga_stream_create(test.mgr, src, BUFFER_FRAMES * 4);
+  ga_sample_source_release(src);
+  test.targets = (gc_int64*)malloc(NUM_ROUNDS * (SEEKS_PER_ROUND + SCRUBS_PER_ROUND + 2) * sizeof(gc_int64));
+  test.numTargets = 0;
+  test.marker = -1;
+  test.landed = -1;
+  test.stopStreaming = 0;
+  test.stopReading = 0;
+  test.slowReading = 0;
+  test.nextFrame = 0;
+  test.numErrors = 0;
+  for(i = 0; i < NUM_STREAM_THREADS; ++i)
+  {
+    streamThreads[i] = gc_thread_create(streamFunc, &test, GC_THREAD_PRIORITY_NORMAL, 0);
+    gc_thread_run(streamThreads[i]);
+  }
+  reader = gc_thread_create(readerFunc, &test, GC_THREAD_PRIORITY_NORMAL, 0);
+  gc_thread_run(reader);
+
+  runRounds(&test);
+
+  /* Once the reader stops, the stream must report the frame it would read next */
+  gc_atomic_store(&test.stopReading, 1);
+  gc_thread_join(reader);
+  gc_thread_destroy(reader);
+  if(!test.numErrors && ga_stream_tell64(test.stream, 0) != test.nextFrame)
+    fail(&test, "final tell position (tell, expected)", ga_stream_tell64(test.stream, 0), test.nextFrame);
+  gc_atomic_store(&test.stopStreaming, 1);
+  ga_stream_manager_wake(test.mgr);
+  for(i = 0; i < NUM_STREAM_THREADS; ++i)
+  {
+    gc_thread_join(streamThreads[i]);
+    gc_thread_destroy(streamThreads[i]);
+  }
+
+  ga_stream_release(test.stream);
+  ga_stream_manager_destroy(test.mgr);
+  free(test.targets);
+  gc_shutdown();
+  printf(test.numErrors ? "FAILED\n" : "PASSED\n");
+  return test.numErrors ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+#include "gorilla/ga.h"
+#include "gorilla/gau.h"
+#include "gorilla/common/gc_thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Scaling benchmark for the stream manager: decodes N looping OGG streams
+   with 1..K stream threads while the main thread drains every stream as
+   fast as it can, and reports the decoding throughput for each thread
+   count. The file is loaded into memory first, so disk speed doesn't
+   enter into it.
+
+   Usage: streambench [file.ogg] [numStreams] [maxStreamThreads] */
+
+#define MAX_STREAMS 256
+#define MAX_STREAM_THREADS 32
+#define RUN_NS 2000000000ull
+#define BUFFER_FRAMES 16384 /* Per stream; the ring buffer needs a power of two */
+#define READ_FRAMES 1024
+
+typedef struct Bench {
+  ga_StreamManager* mgr;
+  volatile gc_int32 stop;
+} Bench;
+
+static gc_int32 streamFunc(void* in_context)
+{
+  Bench* bench = (Bench*)in_context;
+  while(!gc_atomic_load(&bench->stop))
+  {
+    ga_stream_manager_buffer(bench->mgr);
+    ga_stream_manager_wait(bench->mgr, 5);
+  }
+  return 0;
+}
+static ga_BufferedStream* createStream(ga_StreamManager* in_mgr, ga_Memory* in_file, ga_Format* out_format)
+{
+  ga_DataSource* dataSrc = gau_data_source_create_memory(in_file);
+  ga_SampleSource* oggSrc = gau_sample_source_create_ogg(dataSrc);
+  gau_SampleSourceLoop* loopSrc;
+  ga_BufferedStream* ret;
+  ga_data_source_release(dataSrc);
+  if(!oggSrc)
+    return 0;
+  loopSrc = gau_sample_source_create_loop(oggSrc);
+  gau_sample_source_loop_set(loopSrc, -1, 0); /* Loop the whole file, so it never runs out */
+  ga_sample_source_release(oggSrc);
+  ga_sample_source_format((ga_SampleSource*)loopSrc, out_format);
+  ret = ga_stream_create(in_mgr, (ga_SampleSource*)loopSrc, BUFFER_FRAMES * ga_format_sampleSize(out_format));
+  ga_sample_source_release((ga_SampleSource*)loopSrc);
+  return ret;
+}
+static double runBench(ga_Memory* in_file, gc_int32 in_numStreams, gc_int32 in_numThreads, gc_int32* out_sampleRate)
+{
+  Bench bench;
+  ga_BufferedStream* streams[MAX_STREAMS];
+  gc_Thread* threads[MAX_STREAM_THREADS];
+  ga_Format format;
+  char* buffer = 0;
+  gc_int64 numFrames = 0;
+  gc_uint64 start, elapsed;
+  gc_int32 i;
+  bench.mgr = ga_stream_manager_create();
+  bench.stop = 0;
+  for(i = 0; i < in_numStreams; ++i)
+  {
+    streams[i] = createStream(bench.mgr, in_file, &format);
+    if(!streams[i])
+    {
+      in_numStreams = i;
+      break;
+    }
+  }
+  if(in_numStreams)
+  {
+    buffer = (char*)malloc(READ_FRAMES * ga_format_sampleSize(&format));
+    *out_sampleRate = format.sampleRate;
+  }
+  for(i = 0; i < in_numThreads; ++i)
+  {
+    threads[i] = gc_thread_create(streamFunc, &bench, GC_THREAD_PRIORITY_NORMAL, 0);
+    gc_thread_run(threads[i]);
+  }
+
+  /* Drain every stream; whatever was decoded in the meantime is read */
+  start = gc_time_ns();
+  do
+  {
+    gc_int32 numRead = 0;
+    for(i = 0; i < in_numStreams; ++i)
+      numRead += ga_stream_read(streams[i], buffer, READ_FRAMES);
+    if(!numRead)
+      gc_thread_sleep(0); /* All empty; let the stream threads run */
+    numFrames += numRead;
+    elapsed = gc_time_ns() - start;
+  } while(in_numStreams && elapsed < RUN_NS);
+
+  gc_atomic_store(&bench.stop, 1);
+  ga_stream_manager_wake(bench.mgr);
+  for(i = 0; i < in_numThreads; ++i)
+  {
+    gc_thread_join(threads[i]);
+    gc_thread_destroy(threads[i]);
+  }
+  for(i = 0; i < in_numStreams; ++i)
+    ga_stream_release(streams[i]);
+  ga_stream_manager_destroy(bench.mgr);
+  free(buffer);
+  return in_numStreams ? numFrames * 1e9 / elapsed : -1.0;
+}
+int main(int argc, char** argv)
+{
+  const char* filename = argc > 1 ? argv[1] : "test.ogg";
+  gc_int32 numStreams = argc > 2 ? atoi(argv[2]) : 24;
+  gc_int32 maxThreads = argc > 3 ? atoi(argv[3]) : 4;
+  ga_DataSource* fileSrc;
+  ga_Memory* file;
+  double baseline = 0.0;
+  gc_int32 numThreads;
+  numStreams = numStreams < 1 ? 1 : numStreams > MAX_STREAMS ? MAX_STREAMS : numStreams;
+  maxThreads = maxThreads < 1 ? 1 : maxThreads > MAX_STREAM_THREADS ? MAX_STREAM_THREADS : maxThreads;
+  gc_initialize(0);
+
+  fileSrc = gau_data_source_create_file(filename);
+  file = fileSrc ? ga_memory_create_data_source(fileSrc) : 0;
+  if(fileSrc)
+    ga_data_source_release(fileSrc);
+  if(!file)
+  {
+    printf("Could not read %s\n", filename);
+    gc_shutdown();
+    return 1;
+  }
+
+  printf("%d streams of %s, %.1f s per run\n", numStreams, filename, RUN_NS / 1e9);
+  printf("threads    frames/s  x realtime  speedup\n");
+  for(numThreads = 1; numThreads <= maxThreads; ++numThreads)
+  {
+    gc_int32 sampleRate = 0;
+    double framesPerSec = runBench(file, numStreams, numThreads, &sampleRate);
+    if(framesPerSec < 0.0)
+    {
+      printf("Could not decode %s\n", filename);
+      break;
+    }
+    if(numThreads == 1)
+      baseline = framesPerSec;
+    printf("%7d  %10.0f  %10.1f  %7.2f\n", numThreads, framesPerSec,
+           framesPerSec / sampleRate, framesPerSec / baseline);
+  }
+
+  ga_memory_release(file);
+  gc_shutdown();
+  return 0;
+}
@@ -22,7 +22,7 @@ int main(int argc, char** argv)
 
   /* Initialize library + manager */
   gc_initialize(0);
-  mgr = gau_manager_create_custom(GA_DEVICE_TYPE_DEFAULT, GAU_THREAD_POLICY_MULTI, 4, 512);
+  mgr = gau_manager_create_custom(GA_DEVICE_TYPE_DEFAULT, GAU_THREAD_POLICY_MULTI, 4, 512, 0, 0, 1);
   mixer = gau_manager_mixer(mgr);
   streamMgr = gau_manager_streamManager(mgr);
 
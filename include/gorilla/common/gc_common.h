@@ -30,6 +30,32 @@ extern "C"
  *  \defgroup gc_SystemOps System Operations
  */
 
+/** Real-time memory flags.
+ *
+ *  Flags that control how real-time audio buffers (the mixer, device and
+ *  stream buffers) are allocated. See gc_realtime_alloc().
+ *
+ *  \ingroup gc_SystemOps
+ *  \defgroup realtimeMem Real-Time Memory Flags
+ */
+#define GC_MEMORY_DEFAULT 0 /**< Allocate real-time buffers with allocFunc. \ingroup realtimeMem */
+#define GC_MEMORY_LOCKED 1 /**< Allocate real-time buffers from pre-faulted, locked (mlock) pages. \ingroup realtimeMem */
+#define GC_MEMORY_HUGE_PAGES 2 /**< Back locked buffers of at least one huge page with huge pages where available (requires GC_MEMORY_LOCKED). \ingroup realtimeMem */
+
+/** Real-time safety check modes.
+ *
+ *  Debugging/profiling modes that detect operations which may block a thread
+ *  marked with gc_realtime_thread_set() (such as the mixer thread): calls to
+ *  allocFunc/reallocFunc/freeFunc, and gc_mutex_lock() calls on a mutex that
+ *  is already held by another thread.
+ *
+ *  \ingroup gc_SystemOps
+ *  \defgroup realtimeCheck Real-Time Safety Check Modes
+ */
+#define GC_REALTIME_CHECK_OFF 0 /**< No checks (default). \ingroup realtimeCheck */
+#define GC_REALTIME_CHECK_COUNT 1 /**< Record violations per call site (see gc_realtime_violations()). \ingroup realtimeCheck */
+#define GC_REALTIME_CHECK_TRAP 2 /**< Record violations, then abort() at the offending call. \ingroup realtimeCheck */
+
 /** System allocation policies [\ref POD].
  *
  *  \ingroup gc_SystemOps
@@ -38,6 +64,9 @@ typedef struct gc_SystemOps {
   void* (*allocFunc)(gc_uint32 in_size);
   void* (*reallocFunc)(void* in_ptr, gc_uint32 in_size);
   void (*freeFunc)(void* in_ptr);
+  gc_int32 realtimeMemoryFlags; /**< Real-time buffer flags (see \ref realtimeMem). */
+  gc_int32 realtimeCheckMode; /**< Real-time safety check mode (see \ref realtimeCheck). */
+  gc_int32 mutexProfiling; /**< Set to GC_TRUE to record lock statistics (see gc_mutex_stats()). */
 } gc_SystemOps;
 extern gc_SystemOps* gcX_ops;
 
@@ -49,7 +78,8 @@ extern gc_SystemOps* gcX_ops;
  *  \param in_callbacks You may (optionally) pass in a gc_SystemOps structure
  *                      to define custom allocation functions.  If you do not,
  *                      Gorilla will use standard ANSI C malloc/realloc/free
- *                      functions.
+ *                      functions. Any function left as 0 also uses the
+ *                      standard function. The structure is copied.
  *  \return GC_SUCCESS if library initialized successfully. GC_ERROR_GENERIC
  *          if not.
  */
@@ -66,6 +96,90 @@ gc_result gc_initialize(gc_SystemOps* in_callbacks);
  */
 gc_result gc_shutdown();
 
+/** Real-time memory report [\ref POD].
+ *
+ *  \ingroup gc_SystemOps
+ */
+typedef struct gc_MemoryReport {
+  gc_int32 numBuffers; /**< Number of live real-time buffers. */
+  gc_uint64 totalBytes; /**< Bytes mapped for real-time buffers (page-rounded). */
+  gc_uint64 lockedBytes; /**< Bytes successfully locked into physical memory. */
+  gc_uint64 hugePageBytes; /**< Bytes backed by explicit huge pages. */
+} gc_MemoryReport;
+
+/** Allocates a real-time audio buffer.
+ *
+ *  Used for buffers that are touched by the mixer thread every mix (mixer,
+ *  device and stream buffers). With GC_MEMORY_LOCKED set in
+ *  gc_SystemOps::realtimeMemoryFlags, the buffer is mapped separately,
+ *  pre-faulted and locked into memory so that it can never page-fault.
+ *  Otherwise, it is allocated with allocFunc.
+ *
+ *  \ingroup gc_SystemOps
+ *  \warning If locking fails (e.g. RLIMIT_MEMLOCK is too low), the buffer is
+ *           still returned pre-faulted but unlocked. Use gc_realtime_report()
+ *           to check.
+ */
+void* gc_realtime_alloc(gc_uint32 in_size);
+
+/** Frees a buffer allocated with gc_realtime_alloc().
+ *
+ *  \ingroup gc_SystemOps
+ */
+void gc_realtime_free(void* in_ptr);
+
+/** Reports how much real-time buffer memory is mapped and pinned.
+ *
+ *  \ingroup gc_SystemOps
+ */
+void gc_realtime_report(gc_MemoryReport* out_report);
+
+/** Real-time safety violation types.
+ *
+ *  \ingroup gc_SystemOps
+ *  \defgroup realtimeViolation Real-Time Safety Violation Types
+ */
+#define GC_REALTIME_VIOLATION_ALLOC 1 /**< allocFunc or reallocFunc was called. \ingroup realtimeViolation */
+#define GC_REALTIME_VIOLATION_FREE 2 /**< freeFunc was called. \ingroup realtimeViolation */
+#define GC_REALTIME_VIOLATION_LOCK 3 /**< gc_mutex_lock() had to wait for another thread. \ingroup realtimeViolation */
+
+/** Real-time safety violation record [\ref POD].
+ *
+ *  \ingroup gc_SystemOps
+ */
+typedef struct gc_RealtimeViolation {
+  gc_int32 type; /**< Violation type (see \ref realtimeViolation). */
+  void* callSite; /**< Return address of the offending call (resolve with addr2line or a debugger). */
+  gc_int32 count; /**< Number of times this call site has violated. */
+} gc_RealtimeViolation;
+
+/** Retrieves the violations recorded on real-time threads, one per call site.
+ *
+ *  \ingroup gc_SystemOps
+ *  \param out_violations Array to receive the records (may be 0 if in_max is 0).
+ *  \param in_max Capacity of out_violations.
+ *  \return Total number of violations recorded since initialization or the last
+ *          gc_realtime_reset().
+ */
+gc_int32 gc_realtime_violations(gc_RealtimeViolation* out_violations, gc_int32 in_max);
+
+/** Clears all recorded real-time safety violations.
+ *
+ *  \ingroup gc_SystemOps
+ *  \warning Must not be called while a real-time thread may be recording violations.
+ */
+void gc_realtime_reset();
+
+/* Internal: records a real-time safety violation from a marked thread */
+void gcX_realtime_violation(gc_int32 in_type, void* in_callSite);
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define GCX_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define GCX_RETURN_ADDRESS() __builtin_return_address(0)
+#endif /* _MSC_VER */
+
 /***********************/
 /**  Circular Buffer  **/
 /***********************/
@@ -75,6 +189,13 @@ gc_result gc_shutdown();
  *  \defgroup gc_CircBuffer Circular Buffer
  */
 
+/** Size of a CPU cache line (in bytes), used to keep data written by
+ *  different threads apart.
+ *
+ *  \ingroup gc_CircBuffer
+ */
+#define GC_CACHE_LINE_SIZE 64
+
 /** Circular buffer object [\ref SINGLE_CLIENT].
  *
  *  A circular buffer object that is thread-safe for single producer/single
@@ -82,6 +203,11 @@ gc_result gc_shutdown();
  *  data, and a single thread consuming (reading) data. The producer and 
  *  consumer threads may be the same thread.
  *
+ *  The buffer is lock-free: the producer publishes data by storing nextFree
+ *  with release semantics, and the consumer releases space by storing
+ *  nextAvail with release semantics. Each side loads the other's index with
+ *  acquire semantics. The two indices are kept on separate cache lines.
+ *
  *  \ingroup gc_CircBuffer
  *  \warning While it can be read/written from two different threads, the
  *           objects memory management policy is Single Client, since there
@@ -91,8 +217,13 @@ gc_result gc_shutdown();
 typedef struct gc_CircBuffer {
   gc_uint8* data;
   gc_uint32 dataSize;
-  volatile gc_uint32 nextAvail;
-  volatile gc_uint32 nextFree;
+  gc_int32 mirrored; /**< Whether data is mapped twice back-to-back (see gc_buffer_create_mirrored()). */
+  gc_int32 mirrorLocked; /**< Whether the mirrored pages are locked in memory. */
+  gc_uint8 padAvail[GC_CACHE_LINE_SIZE];
+  volatile gc_uint32 nextAvail; /**< Read index (written by the consumer only). */
+  gc_uint8 padFree[GC_CACHE_LINE_SIZE];
+  volatile gc_uint32 nextFree; /**< Write index (written by the producer only). */
+  gc_uint8 padEnd[GC_CACHE_LINE_SIZE];
 } gc_CircBuffer;
 
 /** Create a circular buffer object.
@@ -101,6 +232,21 @@ typedef struct gc_CircBuffer {
  */
 gc_CircBuffer* gc_buffer_create(gc_uint32 in_size);
 
+/** Create a mirrored circular buffer object.
+ *
+ *  The buffer memory is mapped twice, back-to-back, so that any span of up to
+ *  in_size bytes is contiguous regardless of the wrap position.
+ *  gc_buffer_getFree() and gc_buffer_getAvail() then always return a single
+ *  region.
+ *
+ *  \ingroup gc_CircBuffer
+ *  \param in_size Size of the buffer (in bytes). Must be a power-of-two.
+ *  \return Newly-created circular buffer object. If the platform cannot
+ *          mirror the buffer (or in_size is not a multiple of the page size),
+ *          a regular buffer is created instead, with mirrored set to 0.
+ */
+gc_CircBuffer* gc_buffer_create_mirrored(gc_uint32 in_size);
+
 /** Destroy a circular buffer object.
  *
  *  \ingroup gc_CircBuffer
@@ -173,6 +319,111 @@ void gc_buffer_produce(gc_CircBuffer* in_buffer, gc_uint32 in_numBytes);
  */
 void gc_buffer_consume(gc_CircBuffer* in_buffer, gc_uint32 in_numBytes);
 
+/** Make bytes that have been read from the buffer readable again.
+ *
+ *  Never makes more than the buffer's size readable; the bytes beyond that
+ *  have been overwritten.
+ *
+ *  \ingroup gc_CircBuffer
+ *  \return Number of bytes made readable again.
+ *  \warning Only valid if the producer has not overwritten those bytes, i.e.
+ *           if it keeps at least in_numBytes of free space unused.
+ */
+gc_uint32 gc_buffer_unconsume(gc_CircBuffer* in_buffer, gc_uint32 in_numBytes);
+
+/***********************/
+/**  Mapped File  **/
+/***********************/
+/** Read-only memory-mapped file and associated functions.
+ *
+ *  \ingroup common
+ *  \defgroup gc_MappedFile Mapped File
+ */
+
+/** Read-only memory-mapped file data structure [\ref SINGLE_CLIENT].
+ *
+ *  \ingroup gc_MappedFile
+ */
+typedef struct gc_MappedFile {
+  void* data; /**< Start of the mapping (0 for empty files). */
+  gc_int64 size; /**< Size of the file (in bytes). */
+  void* handle; /**< Platform mapping handle. */
+} gc_MappedFile;
+
+/** Maps a file into memory, read-only.
+ *
+ *  Pages are loaded on first access, so mapping is cheap regardless of the
+ *  file's size.
+ *
+ *  \ingroup gc_MappedFile
+ *  \return Newly-created mapping, or 0 if the file could not be opened or
+ *          mapped.
+ *  \warning The whole file must fit the address space: on 32-bit targets,
+ *           mapping a file over 2 GB fails.
+ */
+gc_MappedFile* gc_file_map(const char* in_filename);
+
+/** Unmaps a file mapped by gc_file_map().
+ *
+ *  \ingroup gc_MappedFile
+ *  \warning Never use the mapping's data after it has been unmapped.
+ */
+void gc_file_unmap(gc_MappedFile* in_file);
+
+/***********************/
+/**  Shared File  **/
+/***********************/
+/** Shared read-only file and associated functions.
+ *
+ *  \ingroup common
+ *  \defgroup gc_File Shared File
+ */
+
+/** Shared read-only file data structure [\ref MULTI_CLIENT].
+ *
+ *  A single open file descriptor, read with positional reads (pread), so any
+ *  number of clients can read from it concurrently, each at its own offset,
+ *  without locking.
+ *
+ *  \ingroup gc_File
+ */
+typedef struct gc_File {
+  void* handle; /**< Platform file handle. */
+  gc_int64 size; /**< Size of the file (in bytes) when it was opened. */
+  volatile gc_int32 refCount;
+} gc_File;
+
+/** Opens a file for shared reading.
+ *
+ *  The returned file has an initial reference count of 1.
+ *
+ *  \ingroup gc_File
+ *  \return Newly-opened file, or 0 if the file could not be opened.
+ */
+gc_File* gc_file_open(const char* in_filename);
+
+/** Reads from a file at a given offset.
+ *
+ *  Does not use or change any shared file position.
+ *
+ *  \ingroup gc_File
+ *  \return Number of bytes read (less than in_numBytes at the end of the
+ *          file), or -1 on error.
+ */
+gc_int32 gc_file_read_at(gc_File* in_file, void* in_dst, gc_int32 in_numBytes, gc_int64 in_offset);
+
+/** Acquires a reference for a file.
+ *
+ *  \ingroup gc_File
+ */
+void gc_file_acquire(gc_File* in_file);
+
+/** Releases a reference on a file, closing it when the last one is released.
+ *
+ *  \ingroup gc_File
+ */
+void gc_file_release(gc_File* in_file);
+
 /***********************/
 /**  Linked List  **/
 /***********************/
@@ -215,6 +466,66 @@ void gc_list_link(gc_Link* in_head, gc_Link* in_link, void* in_data);
  */
 void gc_list_unlink(gc_Link* in_link);
 
+/**********************/
+/**  Lock-Free Queue  **/
+/**********************/
+/** Lock-free queue data structure and associated functions.
+ *
+ *  \ingroup common
+ *  \defgroup gc_Queue Lock-Free Queue
+ */
+
+/** Lock-free queue node data structure [POD].
+ *
+ *  Nodes are embedded in the objects being queued (like gc_Link). A node may
+ *  only be in one queue at a time, but may be pushed again once it has been
+ *  popped.
+ *
+ *  \ingroup gc_Queue
+ */
+typedef struct gc_QueueNode {
+  struct gc_QueueNode* volatile next;
+  void* data;
+} gc_QueueNode;
+
+/** Lock-free queue data structure [\ref SINGLE_CLIENT].
+ *
+ *  An intrusive FIFO queue that is thread-safe for multiple producer/single
+ *  consumer use cases. Any number of threads may push nodes concurrently,
+ *  but only a single thread may pop nodes. Neither operation blocks or
+ *  allocates memory.
+ *
+ *  \ingroup gc_Queue
+ *  \warning The queue contains its own sentinel node, so it must not be moved
+ *           or copied after gc_queue_init() has been called.
+ */
+typedef struct gc_Queue {
+  gc_QueueNode* volatile head;
+  gc_QueueNode* tail;
+  gc_QueueNode stub;
+} gc_Queue;
+
+/** Initializes an empty queue.
+ *
+ *  \ingroup gc_Queue
+ */
+void gc_queue_init(gc_Queue* in_queue);
+
+/** Pushes a node onto the back of a queue (producer).
+ *
+ *  \ingroup gc_Queue
+ */
+void gc_queue_push(gc_Queue* in_queue, gc_QueueNode* in_node, void* in_data);
+
+/** Pops a node from the front of a queue (consumer).
+ *
+ *  \ingroup gc_Queue
+ *  \return The popped node, or 0 if the queue is empty. A node whose push is
+ *          still in progress on another thread may not be visible until a
+ *          later call.
+ */
+gc_QueueNode* gc_queue_pop(gc_Queue* in_queue);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
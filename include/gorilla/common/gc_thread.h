@@ -32,6 +32,21 @@ extern "C"
 #define GC_THREAD_PRIORITY_HIGH 2 /**< High thread priority. \ingroup threadPrio */
 #define GC_THREAD_PRIORITY_HIGHEST 3 /**< Highest thread priority. \ingroup threadPrio */
 
+/** Enumerated thread scheduling policies.
+ *
+ *  The real-time policies usually require elevated privileges (e.g.
+ *  CAP_SYS_NICE or an RLIMIT_RTPRIO allowance on Linux). If the thread cannot
+ *  be created with the requested policy, it silently falls back to
+ *  GC_THREAD_SCHED_DEFAULT. The policy actually in effect is stored in
+ *  gc_Thread::schedPolicy.
+ *
+ *  \ingroup gc_Thread
+ *  \defgroup threadSched Thread Scheduling Policies
+ */
+#define GC_THREAD_SCHED_DEFAULT 0 /**< Default (time-sharing) scheduling. \ingroup threadSched */
+#define GC_THREAD_SCHED_FIFO 1 /**< Real-time first-in/first-out scheduling. \ingroup threadSched */
+#define GC_THREAD_SCHED_RR 2 /**< Real-time round-robin scheduling. \ingroup threadSched */
+
 /** Thread function callback.
  *
  *  Threads execute functions. Those functions must match this prototype.
@@ -45,6 +60,17 @@ extern "C"
  */
 typedef gc_int32 (*gc_ThreadFunc)(void* in_context);
 
+/** Thread creation parameters [\ref POD].
+ *
+ *  \ingroup gc_Thread
+ */
+typedef struct gc_ThreadParams {
+  gc_int32 priority; /**< Thread priority (see \ref threadPrio). */
+  gc_int32 schedPolicy; /**< Scheduling policy (see \ref threadSched). */
+  gc_int32 stackSize; /**< Stack size in bytes (0 for the platform default). */
+  gc_uint64 affinityMask; /**< Bitmask of CPUs the thread may run on (0 for any CPU). */
+} gc_ThreadParams;
+
 /** Thread data structure [\ref SINGLE_CLIENT].
  *
  *  \ingroup gc_Thread
@@ -56,17 +82,43 @@ typedef struct gc_Thread {
   gc_int32 id;
   gc_int32 priority;
   gc_int32 stackSize;
+  gc_int32 schedPolicy; /**< Scheduling policy in effect (after any fallback). */
+  gc_uint64 affinityMask;
 } gc_Thread;
 
+/** Fills a thread parameters structure with default values.
+ *
+ *  Defaults are normal priority, default scheduling, platform-default stack
+ *  size, and no CPU affinity.
+ *
+ *  \ingroup gc_Thread
+ */
+void gc_thread_params_default(gc_ThreadParams* out_params);
+
 /** Creates a new thread.
  *
  *  The created thread will not run until gc_thread_run() is called on it.
  *
  *  \ingroup gc_Thread
+ *  \return Newly-created thread, or 0 if in_priority is not one of the
+ *          \ref threadPrio values or the thread could not be created.
  */
 gc_Thread* gc_thread_create(gc_ThreadFunc in_threadFunc, void* in_context,
                             gc_int32 in_priority, gc_int32 in_stackSize);
 
+/** Creates a new thread (customizable).
+ *
+ *  The created thread will not run until gc_thread_run() is called on it.
+ *
+ *  \ingroup gc_Thread
+ *  \param in_params Creation parameters. Pass 0 to use the defaults.
+ *  \return Newly-created thread, or 0 if the priority or scheduling policy is
+ *          out of range or the thread could not be created.
+ *  \warning CPU affinity is not supported on OSX, where the mask is ignored.
+ */
+gc_Thread* gc_thread_create_custom(gc_ThreadFunc in_threadFunc, void* in_context,
+                                   gc_ThreadParams* in_params);
+
 /** Runs a thread.
  *
  *  \ingroup gc_Thread
@@ -90,6 +142,13 @@ void gc_thread_join(gc_Thread* in_thread);
  */
 void gc_thread_sleep(gc_uint32 in_ms);
 
+/** Reads a monotonic clock.
+ *
+ *  \ingroup gc_Thread
+ *  \return Time (in nanoseconds) since an unspecified starting point.
+ */
+gc_uint64 gc_time_ns();
+
 /** Destroys a thread object.
  *
  *  \ingroup gc_Thread
@@ -114,14 +173,39 @@ void gc_thread_destroy(gc_Thread* in_thread);
  */
 typedef struct gc_Mutex {
   void* mutex;
+  const char* name; /**< Name tag (lock class) used by the lock statistics. */
+  void* stats; /**< Lock statistics (0 unless gc_SystemOps::mutexProfiling is set). */
 } gc_Mutex;
 
+/** Lock statistics for all mutexes sharing a name [\ref POD].
+ *
+ *  \ingroup gc_Mutex
+ */
+typedef struct gc_MutexStats {
+  const char* name; /**< Name tag given at creation. */
+  gc_int32 numMutexes; /**< Number of mutexes created with this name. */
+  gc_int64 numLocks; /**< Number of acquisitions. */
+  gc_int64 numContended; /**< Number of acquisitions that had to wait for another thread. */
+  gc_int64 waitNs; /**< Total time spent waiting for contended acquisitions (in nanoseconds). */
+} gc_MutexStats;
+
 /** Creates a mutex.
  *
  *  \ingroup gc_Mutex
  */
 gc_Mutex* gc_mutex_create();
 
+/** Creates a mutex with a name tag.
+ *
+ *  When lock profiling is enabled (see gc_SystemOps::mutexProfiling), lock
+ *  statistics are aggregated per name.
+ *
+ *  \ingroup gc_Mutex
+ *  \warning The name is not copied, and must outlive the mutex (use a string
+ *           literal).
+ */
+gc_Mutex* gc_mutex_create_named(const char* in_name);
+
 /** Locks a mutex.
  *
  *  In general, any lock should have a matching unlock().
@@ -146,6 +230,184 @@ void gc_mutex_unlock(gc_Mutex* in_mutex);
  */
 void gc_mutex_destroy(gc_Mutex* in_mutex);
 
+/** Retrieves the most contended lock classes.
+ *
+ *  Requires gc_SystemOps::mutexProfiling. Entries are sorted by number of
+ *  contended acquisitions, then by total wait time.
+ *
+ *  \ingroup gc_Mutex
+ *  \param out_stats Array to receive the statistics.
+ *  \param in_max Capacity of out_stats.
+ *  \return Number of entries written to out_stats.
+ */
+gc_int32 gc_mutex_stats(gc_MutexStats* out_stats, gc_int32 in_max);
+
+/** Resets the lock counters of all lock classes.
+ *
+ *  \ingroup gc_Mutex
+ */
+void gc_mutex_stats_reset();
+
+/***********/
+/*  Event  */
+/***********/
+/** Wakeup event data structure and associated functions.
+ *
+ *  \ingroup common
+ *  \defgroup gc_Event Event
+ */
+
+/** Auto-reset wakeup event thread synchronization primitive data structure [\ref MULTI_CLIENT].
+ *
+ *  Any number of threads may signal or wait on the event. A signal wakes up at
+ *  least one waiting thread; signals made while the event is already signaled
+ *  are coalesced.
+ *
+ *  \ingroup gc_Event
+ */
+typedef struct gc_Event {
+  void* event;
+  volatile gc_int32 signaled; /**< Non-zero between a signal and the wakeup it causes. */
+} gc_Event;
+
+/** Creates an event.
+ *
+ *  \ingroup gc_Event
+ */
+gc_Event* gc_event_create();
+
+/** Signals an event, waking up its waiting thread.
+ *
+ *  Lock-free and allocation-free, so it may be called from real-time threads.
+ *  Only the first signal after a wakeup makes a system call.
+ *
+ *  \ingroup gc_Event
+ */
+void gc_event_signal(gc_Event* in_event);
+
+/** Waits until an event is signaled, or a timeout expires.
+ *
+ *  \ingroup gc_Event
+ *  \param in_event Event to wait on.
+ *  \param in_timeoutMs Maximum time to wait (in milliseconds).
+ *  \return GC_TRUE if the event was signaled, GC_FALSE on timeout.
+ */
+gc_int32 gc_event_wait(gc_Event* in_event, gc_uint32 in_timeoutMs);
+
+/** Destroys an event.
+ *
+ *  \ingroup gc_Event
+ *  \warning Never use an event after it has been destroyed.
+ */
+void gc_event_destroy(gc_Event* in_event);
+
+/************/
+/*  Atomic  */
+/************/
+/** Atomic memory operations.
+ *
+ *  Loads have acquire semantics, stores have release semantics, and
+ *  read-modify-write operations are full barriers.
+ *
+ *  \ingroup common
+ *  \defgroup gc_Atomic Atomic Operations
+ */
+
+/** Atomically loads a pointer (acquire).
+ *
+ *  \ingroup gc_Atomic
+ */
+void* gc_atomic_load_ptr(void* volatile* in_ptr);
+
+/** Atomically stores a pointer (release).
+ *
+ *  \ingroup gc_Atomic
+ */
+void gc_atomic_store_ptr(void* volatile* in_ptr, void* in_value);
+
+/** Atomically loads a 32-bit integer (acquire).
+ *
+ *  \ingroup gc_Atomic
+ */
+gc_int32 gc_atomic_load(volatile gc_int32* in_ptr);
+
+/** Atomically stores a 32-bit integer (release).
+ *
+ *  \ingroup gc_Atomic
+ */
+void gc_atomic_store(volatile gc_int32* in_ptr, gc_int32 in_value);
+
+/** Atomically loads a 64-bit integer (acquire).
+ *
+ *  \ingroup gc_Atomic
+ */
+gc_int64 gc_atomic_load64(volatile gc_int64* in_ptr);
+
+/** Atomically stores a 64-bit integer (release).
+ *
+ *  \ingroup gc_Atomic
+ */
+void gc_atomic_store64(volatile gc_int64* in_ptr, gc_int64 in_value);
+
+/** Atomically exchanges a pointer, returning the previous value.
+ *
+ *  \ingroup gc_Atomic
+ */
+void* gc_atomic_exchange_ptr(void* volatile* in_ptr, void* in_value);
+
+/** Atomically replaces a pointer if it equals an expected value.
+ *
+ *  \ingroup gc_Atomic
+ *  \return The previous value (equal to in_expected if the swap happened).
+ */
+void* gc_atomic_cas_ptr(void* volatile* in_ptr, void* in_expected, void* in_value);
+
+/** Atomically replaces a 32-bit integer if it equals an expected value.
+ *
+ *  \ingroup gc_Atomic
+ *  \return The previous value (equal to in_expected if the swap happened).
+ */
+gc_int32 gc_atomic_cas(volatile gc_int32* in_ptr, gc_int32 in_expected, gc_int32 in_value);
+
+/** Atomically replaces a 64-bit integer if it equals an expected value.
+ *
+ *  \ingroup gc_Atomic
+ *  \return The previous value (equal to in_expected if the swap happened).
+ */
+gc_int64 gc_atomic_cas64(volatile gc_int64* in_ptr, gc_int64 in_expected, gc_int64 in_value);
+
+/** Atomically adds to an integer, returning the new value.
+ *
+ *  \ingroup gc_Atomic
+ */
+gc_int32 gc_atomic_add(volatile gc_int32* in_ptr, gc_int32 in_value);
+
+/** Atomically adds to a 64-bit integer, returning the new value.
+ *
+ *  \ingroup gc_Atomic
+ */
+gc_int64 gc_atomic_add64(volatile gc_int64* in_ptr, gc_int64 in_value);
+
+/*****************************/
+/*  Real-Time Thread Marking  */
+/*****************************/
+/** Marks or unmarks the calling thread as a real-time (audio) thread.
+ *
+ *  While real-time checks are enabled (see gc_SystemOps::realtimeCheckMode),
+ *  allocations and contended mutex locks made from a marked thread are
+ *  reported as violations (see gc_realtime_violations()).
+ *
+ *  \ingroup gc_Thread
+ *  \return The previous mark of the calling thread.
+ */
+gc_int32 gc_realtime_thread_set(gc_int32 in_realtime);
+
+/** Checks whether the calling thread is marked as a real-time thread.
+ *
+ *  \ingroup gc_Thread
+ */
+gc_int32 gc_realtime_thread_get();
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -302,14 +302,47 @@ gc_int32 ga_data_source_read(ga_DataSource* in_dataSrc, void* in_dst, gc_int32 i
 */
 gc_int32 ga_data_source_seek(ga_DataSource* in_dataSrc, gc_int32 in_offset, gc_int32 in_origin);
 
+/** Seek to a 64-bit offset within a data source.
+ *
+ *  Same as ga_data_source_seek(), for data sources larger than 2 GB.
+ *
+ *  \ingroup ga_DataSource
+ */
+gc_int32 ga_data_source_seek64(ga_DataSource* in_dataSrc, gc_int64 in_offset, gc_int32 in_origin);
+
 /** Tells the current read position of a data source.
  *
  *  \ingroup ga_DataSource
  *  \param in_dataSrc Data source to tell the read position of.
- *  \return The current data source read position.
+ *  \return The current data source read position (clamped to 0x7fffffff; see
+ *          ga_data_source_tell64()).
  */
 gc_int32 ga_data_source_tell(ga_DataSource* in_dataSrc);
 
+/** Tells the current 64-bit read position of a data source.
+ *
+ *  \ingroup ga_DataSource
+ */
+gc_int64 ga_data_source_tell64(ga_DataSource* in_dataSrc);
+
+/** Borrows binary data from the data source, without copying it.
+ *
+ *  Returns a pointer to the data source's own copy of its next bytes (such as
+ *  a memory object's data, or a buffered data source's block), and advances
+ *  the read position past them. Fewer than in_maxBytes may be borrowed even
+ *  before the end of the data; borrow again for more.
+ *
+ *  \ingroup ga_DataSource
+ *  \param in_dataSrc Data source from which to borrow.
+ *  \param in_maxBytes Maximum number of bytes to borrow.
+ *  \param out_data Receives a pointer to the borrowed bytes.
+ *  \return Number of bytes borrowed (0 at the end of the data), or -1 if the
+ *          data source does not support borrowing (read it instead).
+ *  \warning The borrowed bytes are read-only, and only valid until the next
+ *           read, seek, or borrow on the data source.
+ */
+gc_int32 ga_data_source_borrow(ga_DataSource* in_dataSrc, gc_int32 in_maxBytes, const void** out_data);
+
 /** Returns the bitfield of flags set for a data source (see \ref globDefs).
  *
  *  \ingroup ga_DataSource
@@ -372,7 +405,7 @@ typedef struct ga_SampleSource ga_SampleSource;
  *  \param in_delta The signed distance from the old position to the new position.
  *  \param in_seekContext The user-specified context provided in ga_sample_source_read().
  */
-typedef void (*tOnSeekFunc)(gc_int32 in_sample, gc_int32 in_delta, void* in_seekContext);
+typedef void (*tOnSeekFunc)(gc_int64 in_sample, gc_int64 in_delta, void* in_seekContext);
 
 /** Reads samples from a samples source.
  *
@@ -388,6 +421,37 @@ typedef void (*tOnSeekFunc)(gc_int32 in_sample, gc_int32 in_delta, void* in_seek
 gc_int32 ga_sample_source_read(ga_SampleSource* in_sampleSrc, void* in_dst, gc_int32 in_numSamples,
                                tOnSeekFunc in_onSeekFunc, void* in_seekContext);
 
+/** Retrieves samples from a sample source without copying or consuming them.
+ *
+ *  Only supported by sample sources that keep their samples in memory, such
+ *  as buffered streams. The samples remain valid until
+ *  ga_sample_source_commit() is called.
+ *
+ *  \ingroup ga_SampleSource
+ *  \param in_sampleSrc Sample source from which to peek.
+ *  \param in_numSamples Maximum number of samples to peek.
+ *  \param out_dataA Set to the first region of samples. Output parameter.
+ *  \param out_samplesA Set to the number of samples in the first region.
+ *                      Output parameter.
+ *  \param out_dataB Set to the second region of samples (or 0). Output
+ *                   parameter.
+ *  \param out_samplesB Set to the number of samples in the second region.
+ *                      Output parameter.
+ *  \return Total number of samples available in both regions, or -1 if the
+ *          sample source does not support peeking.
+ */
+gc_int32 ga_sample_source_peek(ga_SampleSource* in_sampleSrc, gc_int32 in_numSamples,
+                               void** out_dataA, gc_int32* out_samplesA,
+                               void** out_dataB, gc_int32* out_samplesB);
+
+/** Consumes samples previously retrieved with ga_sample_source_peek().
+ *
+ *  \ingroup ga_SampleSource
+ *  \param in_sampleSrc Sample source to consume samples from.
+ *  \param in_numSamples Number of samples to consume.
+ */
+void ga_sample_source_commit(ga_SampleSource* in_sampleSrc, gc_int32 in_numSamples);
+
 /** Checks whether a sample source has reached the end of the stream.
  *
  *  \ingroup ga_SampleSource
@@ -423,16 +487,32 @@ gc_int32 ga_sample_source_ready(ga_SampleSource* in_sampleSrc, gc_int32 in_numSa
  */
 gc_int32 ga_sample_source_seek(ga_SampleSource* in_sampleSrc, gc_int32 in_sampleOffset);
 
+/** Seek to a 64-bit offset (in samples) within a sample source.
+ *
+ *  Same as ga_sample_source_seek(), for sample sources longer than 2^31
+ *  samples (about 12 hours at 48 kHz).
+ *
+ *  \ingroup ga_SampleSource
+ */
+gc_int32 ga_sample_source_seek64(ga_SampleSource* in_sampleSrc, gc_int64 in_sampleOffset);
+
 /** Tells the current sample number of a sample source.
  *
  *  \ingroup ga_SampleSource
  *  \param in_sampleSrc Sample source to tell the current sample number of.
  *  \param out_totalSamples If set, this value will be set to the total number of 
  *                          samples in the sample source. Output parameter.
- *  \return The current sample source sample number.
+ *  \return The current sample source sample number. Values beyond 0x7fffffff
+ *          are clamped (see ga_sample_source_tell64()).
  */
 gc_int32 ga_sample_source_tell(ga_SampleSource* in_sampleSrc, gc_int32* out_totalSamples);
 
+/** Tells the current 64-bit sample number of a sample source.
+ *
+ *  \ingroup ga_SampleSource
+ */
+gc_int64 ga_sample_source_tell64(ga_SampleSource* in_sampleSrc, gc_int64* out_totalSamples);
+
 /** Returns the bitfield of flags set for a sample source (see \ref globDefs).
  *
  *  \ingroup ga_SampleSource
@@ -524,14 +604,55 @@ ga_Memory* ga_memory_create(void* in_data, gc_int32 in_size);
  */
 ga_Memory* ga_memory_create_data_source(ga_DataSource* in_dataSource);
 
+/** Create a shared memory object backed by a read-only file mapping.
+ *
+ *  The file's contents are not copied; pages are loaded as they are first
+ *  accessed. The mapping is released along with the memory object.
+ *  The returned memory object has an initial reference count of 1.
+ *
+ *  \ingroup ga_Memory
+ *  \param in_filename Path of the file to map.
+ *  \return Newly-allocated memory object, or 0 if the file could not be
+ *          mapped.
+ *  \warning The stored data is read-only.
+ *  \warning On 32-bit targets, files over 2 GB cannot be mapped (0 is
+ *           returned). Use ga_memory_size64() for files over 2 GB.
+ */
+ga_Memory* ga_memory_create_mapped(const char* in_filename);
+
+/** Create a shared memory object that views a range of another's data.
+ *
+ *  The data is not copied. The view holds a reference to the viewed memory
+ *  object, so it stays valid after the viewed object is released.
+ *  The returned memory object has an initial reference count of 1.
+ *
+ *  \ingroup ga_Memory
+ *  \param in_mem Memory object to view.
+ *  \param in_offset Offset (in bytes) of the range within in_mem's data.
+ *  \param in_size Size (in bytes) of the range.
+ *  \return Newly-allocated memory object, or 0 if the range is out of bounds.
+ */
+ga_Memory* ga_memory_create_view(ga_Memory* in_mem, gc_int32 in_offset, gc_int32 in_size);
+
 /** Retrieve the size (in bytes) of a memory object's stored data.
  *
  *  \ingroup ga_Memory
  *  \param in_mem Memory object whose stored data size should be retrieved.
- *  \return Size (in bytes) of the memory object's stored data.
+ *  \return Size (in bytes) of the memory object's stored data, clamped to
+ *          0x7fffffff (see ga_memory_size64()).
  */
 gc_int32 ga_memory_size(ga_Memory* in_mem);
 
+/** Retrieve the size (in bytes) of a memory object's stored data (64-bit).
+ *
+ *  Mapped files can exceed 2 GB on 64-bit targets.
+ *
+ *  \ingroup ga_Memory
+ *  \param in_mem Memory object whose stored data size should be retrieved.
+ *  \return Size (in bytes) of the memory object's stored data.
+ */
+gc_int64 ga_memory_size64(ga_Memory* in_mem);
+
 /** Retrieve a pointer to a memory object's stored data.
  *
  *  \ingroup ga_Memory
@@ -740,7 +861,9 @@ gc_result ga_mixer_mix(ga_Mixer* in_mixer, void* out_buffer);
  *
  *  This function should be called regularly. This function (like all other functions
  *  associated with this object) must be called from the main thread. All callbacks 
- *  will be called on the main thread.
+ *  will be called on the main thread. Only handles that have finished or been
+ *  destroyed since the last dispatch are visited, so the cost of dispatching does
+ *  not grow with the number of live handles.
  *
  *  \ingroup ga_Mixer
  *  \param in_mixer Mixer object whose handles' finish callbacks should be dispatched.
@@ -995,6 +1118,14 @@ gc_result ga_handle_getParami(ga_Handle* in_handle,
  */
 gc_result ga_handle_seek(ga_Handle* in_handle, gc_int32 in_sampleOffset);
 
+/** Seek to a 64-bit offset (in samples) within a handle.
+ *
+ *  Same as ga_handle_seek(), for handles longer than 2^31 samples.
+ *
+ *  \ingroup ga_Handle
+ */
+gc_result ga_handle_seek64(ga_Handle* in_handle, gc_int64 in_sampleOffset);
+
 /** Tells the current playback sample number or total samples of a handle.
  *
  *  \ingroup ga_Handle
@@ -1002,10 +1133,20 @@ gc_result ga_handle_seek(ga_Handle* in_handle, gc_int32 in_sampleOffset);
  *  \param in_param Tell value to retrieve (see \ref tellParams).
  *  \return The current handle playback sample number if in_param is set to 
  *          GA_TELL_PARAM_CURRENT. The total number of samples in the handle
- *          if in_param is set to GA_TELL_PARAM_TOTAL.
+ *          if in_param is set to GA_TELL_PARAM_TOTAL. Values beyond 0x7fffffff
+ *          are clamped (see ga_handle_tell64()).
  */
 gc_int32 ga_handle_tell(ga_Handle* in_handle, gc_int32 in_param);
 
+/** Tells the current 64-bit playback sample number or total samples of a
+ *  handle.
+ *
+ *  Same as ga_handle_tell(), without clamping values beyond 0x7fffffff.
+ *
+ *  \ingroup ga_Handle
+ */
+gc_int64 ga_handle_tell64(ga_Handle* in_handle, gc_int32 in_param);
+
 /** Checks whether a handle has at least a given number of available samples.
  *
  *  If the handle has fewer than in_numSamples samples left before it finishes,
@@ -1057,12 +1198,62 @@ typedef struct ga_StreamManager ga_StreamManager;
 ga_StreamManager* ga_stream_manager_create();
 
 /** Fills all buffers managed by a buffered-stream manager.
+ *
+ *  Streams are refilled in bounded chunks, the one closest to running dry
+ *  first. May be called from several threads at once to spread the work; each
+ *  stream is produced by one thread at a time.
  *
  *  \ingroup ga_StreamManager
  *  \param in_mgr The buffered-stream manager whose buffers are to be filled.
  */
 void ga_stream_manager_buffer(ga_StreamManager* in_mgr);
 
+/** Fills the buffers managed by a buffered-stream manager, within a time budget.
+ *
+ *  Like ga_stream_manager_buffer(), but stops once the budget is spent. Work
+ *  is done in bounded chunks, most urgent stream first, so repeated calls
+ *  share the time fairly between streams. The last chunk may overrun the
+ *  budget.
+ *
+ *  \ingroup ga_StreamManager
+ *  \param in_mgr The buffered-stream manager whose buffers are to be filled.
+ *  \param in_budgetUs Time budget (in microseconds).
+ */
+void ga_stream_manager_buffer_budget(ga_StreamManager* in_mgr, gc_uint32 in_budgetUs);
+
+/** Sets the low watermark of the streams managed by a buffered-stream manager.
+ *
+ *  Consuming from a stream whose buffer is filled below the watermark wakes
+ *  up ga_stream_manager_wait(). Seeks and newly-created streams always do.
+ *
+ *  \ingroup ga_StreamManager
+ *  \param in_mgr The buffered-stream manager.
+ *  \param in_fraction Watermark, as a fraction of each stream's buffer size
+ *                     (defaults to 0.75). Keep it above 0.5, the fill level
+ *                     ga_stream_ready() requires after a seek.
+ */
+void ga_stream_manager_set_low_watermark(ga_StreamManager* in_mgr, gc_float32 in_fraction);
+
+/** Waits until a managed stream needs buffering, or a timeout expires.
+ *
+ *  Intended for the thread calling ga_stream_manager_buffer(), in place of a
+ *  fixed sleep.
+ *
+ *  \ingroup ga_StreamManager
+ *  \param in_mgr The buffered-stream manager.
+ *  \param in_timeoutMs Maximum time to wait (in milliseconds).
+ *  \return GC_TRUE if woken up by a stream (or ga_stream_manager_wake()),
+ *          GC_FALSE on timeout.
+ */
+gc_int32 ga_stream_manager_wait(ga_StreamManager* in_mgr, gc_uint32 in_timeoutMs);
+
+/** Wakes up ga_stream_manager_wait().
+ *
+ *  \ingroup ga_StreamManager
+ *  \param in_mgr The buffered-stream manager.
+ */
+void ga_stream_manager_wake(ga_StreamManager* in_mgr);
+
 /** Destroys a buffered-stream manager.
  *
  *  \ingroup ga_StreamManager
@@ -1128,6 +1319,37 @@ void ga_stream_produce(ga_BufferedStream* in_stream); /* Can be called from a se
  */
 gc_int32 ga_stream_read(ga_BufferedStream* in_stream, void* in_dst, gc_int32 in_numSamples);
 
+/** Retrieves samples from a buffered stream without copying or consuming them.
+ *
+ *  The samples are returned as up to two regions of the internal buffer
+ *  (the second region is only used when the data wraps around the end of a
+ *  non-mirrored buffer). They remain valid until ga_stream_commit() is called.
+ *
+ *  \ingroup ga_BufferedStream
+ *  \param in_stream Buffered stream from which to peek.
+ *  \param in_numSamples Maximum number of samples to peek.
+ *  \param out_dataA Set to the first region. Output parameter.
+ *  \param out_samplesA Set to the number of samples in the first region.
+ *                      Output parameter.
+ *  \param out_dataB Set to the second region (or 0). Output parameter.
+ *  \param out_samplesB Set to the number of samples in the second region.
+ *                      Output parameter.
+ *  \return Total number of samples available in both regions.
+ *  \warning Must only be called by the consumer of the stream.
+ */
+gc_int32 ga_stream_peek(ga_BufferedStream* in_stream, gc_int32 in_numSamples,
+                        void** out_dataA, gc_int32* out_samplesA,
+                        void** out_dataB, gc_int32* out_samplesB);
+
+/** Consumes samples previously retrieved with ga_stream_peek().
+ *
+ *  \ingroup ga_BufferedStream
+ *  \param in_stream Buffered stream to consume samples from.
+ *  \param in_numSamples Number of samples to consume. Must not exceed the
+ *                       number of samples returned by ga_stream_peek().
+ */
+void ga_stream_commit(ga_BufferedStream* in_stream, gc_int32 in_numSamples);
+
 /** Checks whether a buffered stream has reached the end of the stream.
  *
  *  \ingroup ga_BufferedStream
@@ -1141,7 +1363,10 @@ gc_int32 ga_stream_end(ga_BufferedStream* in_stream);
  *
  *  If the sample source has fewer than in_numSamples samples left before it
  *  finishes, this function will returns GA_TRUE regardless of the number of
- *  samples.
+ *  samples. After creation or a seek, the stream is not ready until half of
+ *  its buffer has been filled. Once it has been read from, it stays ready, so
+ *  that a reader keeps playing whatever is buffered; a read that comes up
+ *  short counts as an underrun (see ga_stream_underruns()).
  *
  *  \ingroup ga_BufferedStream
  *  \param in_stream Buffered stream to check.
@@ -1152,7 +1377,23 @@ gc_int32 ga_stream_end(ga_BufferedStream* in_stream);
  */
 gc_int32 ga_stream_ready(ga_BufferedStream* in_stream, gc_int32 in_numSamples);
 
+/** Retrieves the number of underruns of a buffered stream.
+ *
+ *  An underrun is a ga_stream_read() or ga_stream_peek() that returned fewer
+ *  samples than requested while the stream was playing (not after a seek or
+ *  at the end of the source), i.e. a gap that reached the output.
+ *
+ *  \ingroup ga_BufferedStream
+ *  \param in_stream Buffered stream to query.
+ *  \return Number of underruns since the stream was created.
+ */
+gc_int32 ga_stream_underruns(ga_BufferedStream* in_stream);
+
 /** Seek to an offset (in samples) within a buffered stream.
+ *
+ *  Targets that are still buffered ahead of the read position, or within a
+ *  short history window behind it, are served without seeking the contained
+ *  sample source.
  *
  *  \ingroup ga_BufferedStream
  *  \param in_stream Buffered stream to seek within.
@@ -1165,16 +1406,33 @@ gc_int32 ga_stream_ready(ga_BufferedStream* in_stream, gc_int32 in_numSamples);
  */
 gc_int32 ga_stream_seek(ga_BufferedStream* in_stream, gc_int32 in_sampleOffset);
 
+/** Seek to a 64-bit offset (in samples) within a buffered stream.
+ *
+ *  Same as ga_stream_seek(), for streams longer than 2^31 samples.
+ *
+ *  \ingroup ga_BufferedStream
+ */
+gc_int32 ga_stream_seek64(ga_BufferedStream* in_stream, gc_int64 in_sampleOffset);
+
 /** Tells the current sample number of a buffered stream.
  *
  *  \ingroup ga_BufferedStream
  *  \param in_stream Buffered stream to tell the current sample number of.
  *  \param out_totalSamples If set, this value will be set to the total number of 
  *                          samples in the contained sample source. Output parameter.
- *  \return The current sample source sample number.
+ *  \return The current sample source sample number (clamped to 0x7fffffff;
+ *          see ga_stream_tell64()).
  */
 gc_int32 ga_stream_tell(ga_BufferedStream* in_stream, gc_int32* out_totalSamples);
 
+/** Tells the current 64-bit sample number of a buffered stream.
+ *
+ *  Same as ga_stream_tell(), without clamping values beyond 0x7fffffff.
+ *
+ *  \ingroup ga_BufferedStream
+ */
+gc_int64 ga_stream_tell64(ga_BufferedStream* in_stream, gc_int64* out_totalSamples);
+
 /** Returns the bitfield of flags set for a buffered stream (see \ref globDefs).
  *
  *  \ingroup ga_BufferedStream
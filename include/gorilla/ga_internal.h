@@ -49,6 +49,12 @@ struct ga_Device {
   GA_DEVICE_HEADER
 };
 
+/** Clamps a 64-bit offset or position for the 32-bit API (to 0x7fffffff).
+ *
+ *  \ingroup internal
+ */
+gc_int32 gaX_clamp32(gc_int64 in_value);
+
 /*****************/
 /*  Data Source  */
 /*****************/
@@ -82,7 +88,7 @@ typedef gc_int32 (*tDataSourceFunc_Read)(void* in_context, void* in_dst, gc_int3
  *           an invalid seek request.
  *  \todo Define a less-confusing contract for extending/defining this function.
  */
-typedef gc_int32 (*tDataSourceFunc_Seek)(void* in_context, gc_int32 in_offset, gc_int32 in_origin);
+typedef gc_int32 (*tDataSourceFunc_Seek)(void* in_context, gc_int64 in_offset, gc_int32 in_origin);
 
 /** Data source tell callback prototype.
  *
@@ -90,7 +96,19 @@ typedef gc_int32 (*tDataSourceFunc_Seek)(void* in_context, gc_int32 in_offset, g
  *  \param in_context User context (pointer to the first byte after the data source).
  *  \return The current data source read position.
  */
-typedef gc_int32 (*tDataSourceFunc_Tell)(void* in_context);
+typedef gc_int64 (*tDataSourceFunc_Tell)(void* in_context);
+
+/** Data source borrow callback prototype.
+ *
+ *  \ingroup intDataSource
+ *  \param in_context User context (pointer to the first byte after the data source).
+ *  \param in_maxBytes Maximum number of bytes to borrow.
+ *  \param out_data Receives a pointer to the borrowed bytes.
+ *  \return Number of bytes borrowed (0 at the end of the data).
+ *  \warning The borrowed bytes must stay valid until the next read, seek, or
+ *           borrow on the data source.
+ */
+typedef gc_int32 (*tDataSourceFunc_Borrow)(void* in_context, gc_int32 in_maxBytes, const void** out_data);
 
 /** Data source close callback prototype.
  *
@@ -112,6 +130,7 @@ struct ga_DataSource {
   tDataSourceFunc_Read readFunc; /**< Internal read callback. */
   tDataSourceFunc_Seek seekFunc; /**< Internal seek callback (optional). */
   tDataSourceFunc_Tell tellFunc; /**< Internal tell callback (optional). */
+  tDataSourceFunc_Borrow borrowFunc; /**< Internal borrow callback (optional). */
   tDataSourceFunc_Close closeFunc; /**< Internal close callback (optional). */
   gc_int32 refCount; /**< Reference count. */
   gc_Mutex* refMutex; /**< Mutex to protect reference count manipulations. */
@@ -134,9 +153,13 @@ typedef gc_int32 (*tSampleSourceFunc_Read)(void* in_context, void* in_dst, gc_in
                                            tOnSeekFunc in_onSeekFunc, void* in_seekContext);
 typedef gc_int32 (*tSampleSourceFunc_End)(void* in_context);
 typedef gc_int32 (*tSampleSourceFunc_Ready)(void* in_context, gc_int32 in_numSamples);
-typedef gc_int32 (*tSampleSourceFunc_Seek)(void* in_context, gc_int32 in_sampleOffset);
-typedef gc_int32 (*tSampleSourceFunc_Tell)(void* in_context, gc_int32* out_totalSamples);
+typedef gc_int32 (*tSampleSourceFunc_Seek)(void* in_context, gc_int64 in_sampleOffset);
+typedef gc_int64 (*tSampleSourceFunc_Tell)(void* in_context, gc_int64* out_totalSamples);
 typedef void (*tSampleSourceFunc_Close)(void* in_context);
+typedef gc_int32 (*tSampleSourceFunc_Peek)(void* in_context, gc_int32 in_numSamples,
+                                           void** out_dataA, gc_int32* out_samplesA,
+                                           void** out_dataB, gc_int32* out_samplesB);
+typedef void (*tSampleSourceFunc_Commit)(void* in_context, gc_int32 in_numSamples);
 
 struct ga_SampleSource {
   tSampleSourceFunc_Read readFunc;
@@ -145,6 +168,8 @@ struct ga_SampleSource {
   tSampleSourceFunc_Seek seekFunc; /* OPTIONAL */
   tSampleSourceFunc_Tell tellFunc; /* OPTIONAL */
   tSampleSourceFunc_Close closeFunc; /* OPTIONAL */
+  tSampleSourceFunc_Peek peekFunc; /* OPTIONAL */
+  tSampleSourceFunc_Commit commitFunc; /* OPTIONAL (required with peekFunc) */
   ga_Format format;
   gc_int32 refCount;
   gc_Mutex* refMutex;
@@ -158,7 +183,9 @@ void ga_sample_source_init(ga_SampleSource* in_sampleSrc);
 /************/
 struct ga_Memory {
   void* data;
-  gc_uint32 size;
+  gc_int64 size;
+  gc_MappedFile* mapping; /* Backing file mapping (0 for heap memory) */
+  struct ga_Memory* parent; /* Memory this is a view into (0 if it owns its data) */
   gc_int32 refCount;
   gc_Mutex* refMutex;
 };
@@ -194,9 +221,12 @@ struct ga_Handle {
   gc_float32 pan;
   gc_Link dispatchLink;
   gc_Link mixLink;
+  gc_QueueNode dispatchNode;
   gc_Mutex* handleMutex;
   ga_SampleSource* sampleSrc;
   volatile gc_int32 finished;
+  gc_int32 retired; /* Removed from the mix list (protected by handleMutex) */
+  gc_int32 queued; /* Pending in the dispatch queue (protected by handleMutex) */
 };
 
 /************/
@@ -207,8 +237,13 @@ struct ga_Mixer {
   ga_Format mixFormat;
   gc_int32 numSamples;
   gc_int32* mixBuffer;
-  gc_Link dispatchList;
-  gc_Mutex* dispatchMutex;
+  void* srcBuffer; /* Scratch buffer for sources that cannot be peeked (mix thread only) */
+  gc_int32 srcBufferSize;
+  void* srcBufferPending; /* Larger scratch buffer awaiting the mix thread (protected by mixMutex) */
+  void* srcBufferRetired; /* Scratch buffer the mix thread replaced, to free (protected by mixMutex) */
+  gc_int32 srcBufferReserved; /* Size of the pending (or current) scratch buffer (protected by mixMutex) */
+  gc_Queue dispatchQueue; /* Retired/destroyed handles awaiting dispatch */
+  gc_Link dispatchList; /* Retired handles (dispatch thread only) */
   gc_Link mixList;
   gc_Mutex* mixMutex;
 };
@@ -217,23 +252,57 @@ struct ga_Mixer {
 struct ga_StreamManager {
   gc_Link streamList;
   gc_Mutex* streamListMutex;
+  gc_Event* wakeEvent; /* Signaled by streams that need buffering */
+  gc_float32 lowWatermark;
+  volatile gc_int32 pass; /* Buffering passes started */
 };
 
+/* A discontinuity in the buffered sample stream (seek or loop). Pushed by the
+   producer before the data it applies to, adopted by the consumer once the
+   read position reaches bytePos. */
+typedef struct gaX_StreamMark {
+  gc_uint32 bytePos; /* Ring position (total bytes produced) the mark applies from */
+  gc_int32 epoch; /* Seek epoch the data belongs to */
+  gc_int64 sample; /* Source sample at bytePos */
+} gaX_StreamMark;
+
+/* A seek request. ga_stream_seek() fills the slot of the epoch it is about
+   to publish, so the target and soft flag are read as one snapshot. */
+#define GAX_STREAM_SEEK_SLOTS 4 /* Power-of-two */
+
+typedef struct gaX_StreamSeek {
+  volatile gc_int64 target;
+  volatile gc_int32 soft; /* May be served from buffered data */
+} gaX_StreamSeek;
+
 struct ga_BufferedStream {
   gc_Link* streamLink;
+  ga_StreamManager* mgr;
   ga_SampleSource* innerSrc;
   gc_CircBuffer* buffer;
-  gc_Mutex* produceMutex;
-  gc_Mutex* seekMutex;
-  gc_Mutex* readMutex;
+  gaX_StreamMark* markRing; /* SPSC ring of marks, allocated inline after the stream */
+  gc_uint32 markCapacity; /* Power-of-two, sized from the buffer length */
+  volatile gc_uint32 markHead; /* Total marks pushed (producer) */
+  volatile gc_uint32 markTail; /* Total marks popped (consumer) */
   gc_Mutex* refMutex;
   gc_int32 refCount;
-  gc_Link tellJumps;
   ga_Format format;
-  gc_int32 seek;
-  gc_int32 tell;
-  gc_int32 nextSample;
-  gc_int32 end;
+  volatile gc_int32 seekEpoch; /* Even: a ga_stream_seek() request; odd: its retry as a full seek */
+  gaX_StreamSeek seekRing[GAX_STREAM_SEEK_SLOTS]; /* Requests, indexed by epoch / 2 */
+  volatile gc_int32 startEpoch; /* Latest epoch the producer has started producing */
+  volatile gc_uint32 startPos; /* Ring position where startEpoch's data starts */
+  volatile gc_int32 endEpoch; /* Epoch in which the producer reached the end of the source */
+  volatile gc_int64 tell; /* Published by the consumer */
+  volatile gc_int32 tellEpoch;
+  volatile gc_int32 numUnderruns;
+  gc_int32 produceEpoch; /* Producer-only */
+  gc_uint32 readBase; /* Producer-only: ring position of the current inner read */
+  gaX_StreamMark writeMark; /* Producer-only: last mark pushed */
+  gaX_StreamMark readMark; /* Consumer-only: mark governing the data at the read position */
+  gc_int32 readEpoch; /* Consumer-only: latest seek epoch handled */
+  gc_int32 validEpoch; /* Consumer-only: marks from older epochs are stale */
+  gc_uint32 readHighWater; /* Consumer-only: furthest read position; history is kept behind it */
+  gc_int32 historyBytes; /* Consumed bytes the producer leaves intact for backward seeks */
   gc_int32 flags;
   gc_int32 bufferSize;
 };
@@ -45,6 +45,27 @@ typedef struct gau_Manager gau_Manager;
 #define GAU_THREAD_POLICY_UNKNOWN 0 /**< Unknown thread policy. \ingroup threadPolicy */
 #define GAU_THREAD_POLICY_SINGLE 1 /**< Single-threaded policy (does not use background threads). \ingroup threadPolicy */
 #define GAU_THREAD_POLICY_MULTI 2 /**< Multi-threaded mode (uses background threads). \ingroup threadPolicy */
+#define GAU_THREAD_POLICY_JOBS 3 /**< Job-system mode (runs its work as jobs on a user-supplied scheduler). \ingroup threadPolicy */
+
+/** Job function prototype.
+ *
+ *  \ingroup gau_Manager
+ *  \param in_jobContext The job context passed to gau_JobSystem::submitFunc.
+ */
+typedef void (*gau_JobFunc)(void* in_jobContext);
+
+/** User job scheduler interface for GAU_THREAD_POLICY_JOBS [\ref POD].
+ *
+ *  \ingroup gau_Manager
+ */
+typedef struct gau_JobSystem {
+  /** Schedules a job to run in_func(in_jobContext), returning a handle to
+      pass to waitFunc. Jobs may run concurrently with each other. */
+  void* (*submitFunc)(gau_JobFunc in_func, void* in_jobContext, void* in_userContext);
+  /** Waits until a submitted job has run (and releases its handle). */
+  void (*waitFunc)(void* in_job, void* in_userContext);
+  void* userContext; /**< Passed to submitFunc and waitFunc. */
+} gau_JobSystem;
 
 /** Creates an audio manager.
  *
@@ -52,14 +73,56 @@ typedef struct gau_Manager gau_Manager;
  */
 gau_Manager* gau_manager_create();
 
+/** Fills a thread parameters structure with the manager's default values.
+ *
+ *  Defaults are high priority, default scheduling, and a 256 KB stack. Start
+ *  from these when customizing the manager's threads.
+ *
+ *  \ingroup gau_Manager
+ */
+void gau_manager_thread_params_default(gc_ThreadParams* out_params);
+
 /** Creates an audio manager (customizable).
 *
 *  \ingroup gau_Manager
+*  \param in_mixThreadParams Parameters for the mixer thread (priority, scheduling
+*                            policy, stack size, CPU affinity). Pass 0 to use
+*                            gau_manager_thread_params_default().
+*  \param in_streamThreadParams Parameters for the stream threads. Pass 0 to use
+*                               gau_manager_thread_params_default().
+*  \param in_numStreamThreads Number of stream threads. Streams are shared
+*                             between them, each produced by one thread at a
+*                             time (see ga_stream_manager_buffer()).
+*  \return Newly-created manager, or 0 if one of its threads could not be
+*          created.
+*  \warning The thread parameters are ignored unless in_threadPolicy is
+*           GAU_THREAD_POLICY_MULTI.
 */
 gau_Manager* gau_manager_create_custom(gc_int32 in_devType,
                                        gc_int32 in_threadPolicy,
                                        gc_int32 in_numBuffers,
-                                       gc_int32 in_bufferSamples);
+                                       gc_int32 in_bufferSamples,
+                                       gc_ThreadParams* in_mixThreadParams,
+                                       gc_ThreadParams* in_streamThreadParams,
+                                       gc_int32 in_numStreamThreads);
+
+/** Creates an audio manager that runs its work on a user job system.
+ *
+ *  Uses GAU_THREAD_POLICY_JOBS: rather than owning threads, each
+ *  gau_manager_update() waits for the jobs submitted by the previous update,
+ *  then submits a mix job and in_numStreamJobs stream jobs. Stream jobs
+ *  share the streams between them, refilling them in small chunks (see
+ *  ga_stream_manager_buffer()).
+ *
+ *  \ingroup gau_Manager
+ *  \param in_jobSystem Job scheduler callbacks (copied).
+ *  \param in_numStreamJobs Number of stream jobs submitted per update.
+ */
+gau_Manager* gau_manager_create_jobs(gc_int32 in_devType,
+                                     gc_int32 in_numBuffers,
+                                     gc_int32 in_bufferSamples,
+                                     gau_JobSystem* in_jobSystem,
+                                     gc_int32 in_numStreamJobs);
 
 /** Updates an audio manager.
  *
@@ -67,6 +130,20 @@ gau_Manager* gau_manager_create_custom(gc_int32 in_devType,
  */
 void gau_manager_update(gau_Manager* in_mgr);
 
+/** Updates an audio manager, within a time budget.
+ *
+ *  Mixes first, then spends the rest of the budget refilling streams in small
+ *  chunks, most urgent stream first (see ga_stream_manager_buffer_budget()).
+ *  Time spent over budget is deducted from the next call's budget.
+ *
+ *  \ingroup gau_Manager
+ *  \param in_mgr The audio manager.
+ *  \param in_budgetUs Time budget (in microseconds).
+ *  \warning Only useful with GAU_THREAD_POLICY_SINGLE; with other policies
+ *           this is the same as gau_manager_update().
+ */
+void gau_manager_update_budget(gau_Manager* in_mgr, gc_uint32 in_budgetUs);
+
 /** Retrieves the internal mixer object from an audio manager.
  *
  *  \ingroup gau_Manager
@@ -110,7 +187,21 @@ ga_DataSource* gau_data_source_create_file(const char* in_filename);
  *
  *  \ingroup concreteData
  */
-ga_DataSource* gau_data_source_create_file_arc(const char* in_filename, gc_int32 in_offset, gc_int32 in_size);
+ga_DataSource* gau_data_source_create_file_arc(const char* in_filename, gc_int64 in_offset, gc_int64 in_size);
+
+/** Creates a data source of bytes from a subregion of a shared file.
+ *
+ *  Reads are positional reads on the shared file, at this data source's own
+ *  offset, so data sources sharing a file never contend with each other.
+ *
+ *  \ingroup concreteData
+ *  \param in_file File to read from (the data source acquires a reference).
+ *  \param in_offset Offset (in bytes) of the subregion within the file.
+ *  \param in_size Size (in bytes) of the subregion, or -1 to extend to the end
+ *                 of the file.
+ *  \return Newly-created data source, or 0 if in_offset is out of bounds.
+ */
+ga_DataSource* gau_data_source_create_file_shared(gc_File* in_file, gc_int64 in_offset, gc_int64 in_size);
 
 /** Creates a data source of bytes from a block of shared memory.
  *
@@ -118,6 +209,314 @@ ga_DataSource* gau_data_source_create_file_arc(const char* in_filename, gc_int32
  */
 ga_DataSource* gau_data_source_create_memory(ga_Memory* in_memory);
 
+/** Creates a data source of bytes from a memory-mapped file-on-disk.
+ *
+ *  Reads are served straight from the mapping, with no system calls. Use
+ *  ga_memory_create_mapped() and gau_data_source_create_memory() instead
+ *  to access the mapped bytes directly (see ga_memory_data()).
+ *
+ *  Files over 2 GB are supported on 64-bit targets (see ga_data_source_tell64()).
+ *  On 32-bit targets they do not fit the address space, so mapping them fails;
+ *  use gau_data_source_create_file() for those.
+ *
+ *  \ingroup concreteData
+ *  \return Newly-created data source, or 0 if the file could not be mapped.
+ */
+ga_DataSource* gau_data_source_create_mmap(const char* in_filename);
+
+/** Creates a data source that buffers small reads from another data source.
+ *
+ *  Reads smaller than the buffer are served from a local block, refilled
+ *  with one read of the source when it runs out; larger reads go straight
+ *  through once the buffer is drained. Seeks within the buffered block only
+ *  move the cursor; other seeks discard the block.
+ *
+ *  \ingroup concreteData
+ *  \param in_dataSrc Data source to read (the buffered data source acquires
+ *                    a reference). Only read it through the buffered data
+ *                    source from then on.
+ *  \param in_bufferSize Size (in bytes) of the local block (e.g. 4096).
+ *  \return Newly-created data source.
+ *  \warning The buffered data source is not thread-safe (it does not lock);
+ *           serialize access to it, as the sample sources do.
+ */
+ga_DataSource* gau_data_source_create_buffered(ga_DataSource* in_dataSrc, gc_int32 in_bufferSize);
+
+/*******************/
+/**  Block Cache  **/
+/*******************/
+/** Fixed-budget caches of file blocks, shared by many data sources.
+ *
+ *  A block cache holds fixed-size blocks of file data, keyed by file name and
+ *  block offset, and evicts the least recently used block when full. Data
+ *  sources created with gau_data_source_create_file_cached() read through the
+ *  cache, so replaying a file (even from a new data source) reads it from
+ *  memory instead of disk. Files are assumed not to change while cached.
+ *
+ *  \ingroup utility
+ *  \defgroup gau_BlockCache Block Cache
+ */
+
+/** Block cache data structure [\ref MULTI_CLIENT].
+ *
+ *  \ingroup gau_BlockCache
+ */
+typedef struct gau_BlockCache gau_BlockCache;
+
+/** Block cache statistics [\ref POD].
+ *
+ *  \ingroup gau_BlockCache
+ */
+typedef struct gau_BlockCacheStats {
+  gc_int64 hits; /**< Block lookups served from the cache */
+  gc_int64 misses; /**< Block lookups that had to read from the file */
+  gc_int64 readAheads; /**< Blocks read ahead of a sequential reader */
+  gc_int64 evictions; /**< Blocks evicted to make room for others */
+  gc_int64 bytesRead; /**< Bytes read from files */
+} gau_BlockCacheStats;
+
+/** Creates a block cache.
+ *
+ *  \ingroup gau_BlockCache
+ *  \param in_blockSize Size (in bytes) of each block (e.g. 65536).
+ *  \param in_budget Total size (in bytes) of the cached blocks. The cache
+ *                   holds in_budget / in_blockSize blocks (at least 1).
+ *  \param in_readAheadBlocks Number of blocks to read ahead, in the same
+ *                            read, when a sequential reader misses. The
+ *                            read-ahead buffer is allocated with the cache and
+ *                            used by one reader at a time; meanwhile, other
+ *                            readers read only the block they miss.
+ *  \return Newly-created block cache.
+ */
+gau_BlockCache* gau_block_cache_create(gc_int32 in_blockSize, gc_int32 in_budget,
+                                       gc_int32 in_readAheadBlocks);
+
+/** Retrieves a block cache's statistics.
+ *
+ *  \ingroup gau_BlockCache
+ *  \param in_cache The block cache.
+ *  \param out_stats Receives the statistics gathered since the cache was
+ *                   created (or its statistics were last reset).
+ */
+void gau_block_cache_stats(gau_BlockCache* in_cache, gau_BlockCacheStats* out_stats);
+
+/** Resets a block cache's statistics to zero.
+ *
+ *  \ingroup gau_BlockCache
+ */
+void gau_block_cache_reset_stats(gau_BlockCache* in_cache);
+
+/** Destroys a block cache.
+ *
+ *  \ingroup gau_BlockCache
+ *  \warning The cache must outlive every data source that reads through it.
+ */
+void gau_block_cache_destroy(gau_BlockCache* in_cache);
+
+/** Creates a data source of bytes from a file-on-disk, read through a block
+ *  cache.
+ *
+ *  The data source keeps a copy of its current block, so small reads are
+ *  served without touching the cache.
+ *
+ *  \ingroup gau_BlockCache
+ *  \return Newly-created data source, or 0 if the file could not be opened.
+ */
+ga_DataSource* gau_data_source_create_file_cached(gau_BlockCache* in_cache, const char* in_filename);
+
+/******************/
+/**  Read-Ahead  **/
+/******************/
+/** Asynchronous read-ahead of data sources on I/O threads.
+ *
+ *  A read-ahead data source reads another data source in large blocks on an
+ *  I/O pool's threads, keeping the next block in flight while the current one
+ *  is consumed. Decoders reading through it only wait on I/O when they
+ *  consume data faster than the underlying source can supply it.
+ *
+ *  \ingroup utility
+ *  \defgroup gau_ReadAhead Read-Ahead
+ */
+
+/** I/O thread pool data structure [\ref MULTI_CLIENT].
+ *
+ *  \ingroup gau_ReadAhead
+ */
+typedef struct gau_IoPool gau_IoPool;
+
+/** Creates an I/O thread pool.
+ *
+ *  \ingroup gau_ReadAhead
+ *  \param in_numThreads Number of I/O threads (at least 1).
+ *  \return Newly-created I/O thread pool.
+ */
+gau_IoPool* gau_io_pool_create(gc_int32 in_numThreads);
+
+/** Destroys an I/O thread pool.
+ *
+ *  \ingroup gau_ReadAhead
+ *  \warning The pool must outlive every data source that reads through it.
+ */
+void gau_io_pool_destroy(gau_IoPool* in_pool);
+
+/** Creates a data source that reads another data source ahead, asynchronously.
+ *
+ *  Two buffers are used: reads are served from one while the pool fills the
+ *  other with the source's next in_bufferSize bytes. Seeks within the current
+ *  buffer are free; other seeks discard both buffers and restart the
+ *  read-ahead at the new position.
+ *
+ *  \ingroup gau_ReadAhead
+ *  \param in_pool I/O thread pool to read on.
+ *  \param in_dataSrc Data source to read (the read-ahead data source acquires
+ *                    a reference). Only the pool's threads read it from then on.
+ *  \param in_bufferSize Size (in bytes) of each buffer (e.g. 262144).
+ *  \return Newly-created data source.
+ */
+ga_DataSource* gau_data_source_create_read_ahead(gau_IoPool* in_pool, ga_DataSource* in_dataSrc,
+                                                 gc_int32 in_bufferSize);
+
+/***************/
+/**  Archive  **/
+/***************/
+/** Pack files of named entries, read through a single shared file.
+ *
+ *  The archive format is little-endian:
+ *  - Header: the magic "GPAK", a 32-bit version (1 or 2), a 32-bit entry
+ *    count, and the offset of the directory table.
+ *  - Directory table: for each entry, its offset and size (in bytes), a 16-bit
+ *    name length, then the name (not NUL-terminated).
+ *
+ *  Offsets and sizes are unsigned 32-bit in version 1 and 64-bit in version 2,
+ *  which allows archives (and entries) larger than 4 GB.
+ *
+ *  \ingroup utility
+ *  \defgroup gau_Archive Archive
+ */
+
+/** Archive data structure [\ref SINGLE_CLIENT].
+ *
+ *  \ingroup gau_Archive
+ */
+typedef struct gau_Archive gau_Archive;
+
+/** Opens an archive.
+ *
+ *  Reads the directory table once into a hash index, and keeps the file open
+ *  for the archive's entries to share.
+ *
+ *  \ingroup gau_Archive
+ *  \return Newly-opened archive, or 0 if the file could not be opened or is
+ *          not a valid archive.
+ */
+gau_Archive* gau_archive_open(const char* in_filename);
+
+/** Creates a data source of bytes from an archive entry.
+ *
+ *  Entry data sources share the archive's file (see
+ *  gau_data_source_create_file_shared()), and remain valid after the archive
+ *  is closed.
+ *
+ *  \ingroup gau_Archive
+ *  \return Newly-created data source, or 0 if there is no entry with that
+ *          name.
+ */
+ga_DataSource* gau_archive_open_entry(gau_Archive* in_archive, const char* in_name);
+
+/** Retrieves the number of entries in an archive.
+ *
+ *  \ingroup gau_Archive
+ */
+gc_int32 gau_archive_num_entries(gau_Archive* in_archive);
+
+/** Closes an archive.
+ *
+ *  \ingroup gau_Archive
+ *  \warning Never use an archive after it has been closed.
+ */
+void gau_archive_close(gau_Archive* in_archive);
+
+/******************/
+/**  Sound Bank  **/
+/******************/
+/** Prebaked banks of named sounds, mapped straight into memory.
+ *
+ *  A sound bank stores decoded PCM, so its sounds play without being
+ *  decoded or copied when loaded. The bank format is little-endian:
+ *  - Header: the magic "GBNK", a 32-bit version (1), a 32-bit sound count,
+ *    and the 32-bit offset of the index.
+ *  - Index: for each sound, the 32-bit offset and size (in bytes) of its PCM
+ *    data, its 32-bit sample rate, 16-bit bits per sample, 16-bit channel
+ *    count, a 16-bit name length, then the name (not NUL-terminated).
+ *  - PCM data: each sound's samples, starting on a GAU_SOUND_BANK_ALIGNMENT
+ *    boundary.
+ *
+ *  Banks are built with gau_sound_bank_write() (see the soundbank tool).
+ *
+ *  \ingroup utility
+ *  \defgroup gau_SoundBank Sound Bank
+ */
+
+/** Alignment (in bytes) of each sound's PCM data within a sound bank.
+ *
+ *  \ingroup gau_SoundBank
+ */
+#define GAU_SOUND_BANK_ALIGNMENT 4096
+
+/** Sound bank data structure [\ref SINGLE_CLIENT].
+ *
+ *  \ingroup gau_SoundBank
+ */
+typedef struct gau_SoundBank gau_SoundBank;
+
+/** Opens a sound bank.
+ *
+ *  Maps the file (see ga_memory_create_mapped()) and reads its index. Each
+ *  sound's PCM data is paged in the first time it is played.
+ *
+ *  \ingroup gau_SoundBank
+ *  \return Newly-opened sound bank, or 0 if the file could not be mapped or
+ *          is not a valid sound bank.
+ */
+gau_SoundBank* gau_sound_bank_open(const char* in_filename);
+
+/** Retrieves a sound from a sound bank.
+ *
+ *  The sound's memory is a view into the bank's mapping (see
+ *  ga_memory_create_view()), and remains valid after the bank is closed.
+ *
+ *  \ingroup gau_SoundBank
+ *  \return The sound, with a reference acquired for the caller, or 0 if
+ *          there is no sound with that name.
+ */
+ga_Sound* gau_sound_bank_sound(gau_SoundBank* in_bank, const char* in_name);
+
+/** Retrieves the number of sounds in a sound bank.
+ *
+ *  \ingroup gau_SoundBank
+ */
+gc_int32 gau_sound_bank_num_sounds(gau_SoundBank* in_bank);
+
+/** Closes a sound bank.
+ *
+ *  \ingroup gau_SoundBank
+ *  \warning Never use a sound bank after it has been closed.
+ */
+void gau_sound_bank_close(gau_SoundBank* in_bank);
+
+/** Writes sounds to a new sound bank file.
+ *
+ *  \ingroup gau_SoundBank
+ *  \param in_filename Path of the sound bank file to write.
+ *  \param in_numSounds Number of sounds to write.
+ *  \param in_names Names of the sounds (must be unique).
+ *  \param in_sounds Sounds to write.
+ *  \return GC_SUCCESS if the bank was written successfully. GC_ERROR_GENERIC
+ *          if not.
+ */
+gc_result gau_sound_bank_write(const char* in_filename, gc_int32 in_numSounds,
+                               const char** in_names, ga_Sound** in_sounds);
+
 /*******************************/
 /**  Concrete Sample Sources  **/
 /*******************************/
@@ -180,6 +579,15 @@ gau_SampleSourceLoop* gau_sample_source_create_loop(ga_SampleSource* in_sampleSr
  */
 void gau_sample_source_loop_set(gau_SampleSourceLoop* in_sampleSrc, gc_int32 in_triggerSample, gc_int32 in_targetSample);
 
+/** Set 64-bit loop points on a loop sample source.
+ *
+ *  Same as gau_sample_source_loop_set(), for loop points beyond 2^31 samples
+ *  (about 12 hours at 48 kHz).
+ *
+ *  \ingroup loopSample
+ */
+void gau_sample_source_loop_set64(gau_SampleSourceLoop* in_sampleSrc, gc_int64 in_triggerSample, gc_int64 in_targetSample);
+
 /** Clear loop points on a loop sample source.
  *
  *  \ingroup loopSample
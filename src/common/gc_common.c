@@ -1,9 +1,28 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* memfd_create() */
+#endif /* __linux__ */
+#ifndef _WIN32
+#define _FILE_OFFSET_BITS 64 /* 64-bit off_t for pread()/fstat(), even on 32-bit targets */
+#endif /* _WIN32 */
+
 #include "gorilla/common/gc_common.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif /* MAP_ANONYMOUS */
+#endif /* _WIN32 */
+
 /* System Functions */
 gc_SystemOps* gcX_ops = 0;
 
@@ -19,21 +38,314 @@ static void gcX_defaultFreeFunc(void* in_ptr)
 {
   free(in_ptr);
 }
-static gc_SystemOps s_defaultCallbacks;
+static gc_SystemOps s_callbacks;
+static gc_SystemOps s_userCallbacks; /* Wrapped by the real-time checks */
+static gc_Mutex* s_realtimeMutex = 0;
+static gc_MemoryReport s_realtimeReport;
+static gc_uint64 s_hugePageSize = 0; /* Explicit huge page size (0 if unavailable) */
+static gc_uint64 gcX_huge_page_size();
+
+/* Checked System Functions */
+static void* gcX_checkedAllocFunc(gc_uint32 in_size)
+{
+  if(gc_realtime_thread_get())
+    gcX_realtime_violation(GC_REALTIME_VIOLATION_ALLOC, GCX_RETURN_ADDRESS());
+  return s_userCallbacks.allocFunc(in_size);
+}
+static void* gcX_checkedReallocFunc(void* in_ptr, gc_uint32 in_size)
+{
+  if(gc_realtime_thread_get())
+    gcX_realtime_violation(GC_REALTIME_VIOLATION_ALLOC, GCX_RETURN_ADDRESS());
+  return s_userCallbacks.reallocFunc(in_ptr, in_size);
+}
+static void gcX_checkedFreeFunc(void* in_ptr)
+{
+  if(gc_realtime_thread_get())
+    gcX_realtime_violation(GC_REALTIME_VIOLATION_FREE, GCX_RETURN_ADDRESS());
+  s_userCallbacks.freeFunc(in_ptr);
+}
+
 gc_result gc_initialize(gc_SystemOps* in_callbacks)
 {
-  s_defaultCallbacks.allocFunc = &gcX_defaultAllocFunc;
-  s_defaultCallbacks.reallocFunc = &gcX_defaultReallocFunc;
-  s_defaultCallbacks.freeFunc = &gcX_defaultFreeFunc;
-  gcX_ops = in_callbacks ? in_callbacks : &s_defaultCallbacks;
+  memset(&s_callbacks, 0, sizeof(gc_SystemOps));
+  if(in_callbacks)
+    memcpy(&s_callbacks, in_callbacks, sizeof(gc_SystemOps));
+  if(!s_callbacks.allocFunc)
+    s_callbacks.allocFunc = &gcX_defaultAllocFunc;
+  if(!s_callbacks.reallocFunc)
+    s_callbacks.reallocFunc = &gcX_defaultReallocFunc;
+  if(!s_callbacks.freeFunc)
+    s_callbacks.freeFunc = &gcX_defaultFreeFunc;
+  if(s_callbacks.realtimeCheckMode != GC_REALTIME_CHECK_OFF)
+  {
+    memcpy(&s_userCallbacks, &s_callbacks, sizeof(gc_SystemOps));
+    s_callbacks.allocFunc = &gcX_checkedAllocFunc;
+    s_callbacks.reallocFunc = &gcX_checkedReallocFunc;
+    s_callbacks.freeFunc = &gcX_checkedFreeFunc;
+  }
+  gcX_ops = &s_callbacks;
+  gc_realtime_reset();
+  memset(&s_realtimeReport, 0, sizeof(gc_MemoryReport));
+  s_realtimeMutex = gc_mutex_create_named("gc_realtime::reportMutex");
+  s_hugePageSize = s_callbacks.realtimeMemoryFlags & GC_MEMORY_HUGE_PAGES ? gcX_huge_page_size() : 0;
   return GC_SUCCESS;
 }
 gc_result gc_shutdown()
 {
+  gc_mutex_destroy(s_realtimeMutex);
+  s_realtimeMutex = 0;
   gcX_ops = 0;
   return GC_SUCCESS;
 }
 
+/* Real-Time Memory Functions */
+
+/* Precedes each locked buffer; keeps the buffer cache-line aligned */
+typedef struct gcX_RealtimeHeader {
+  gc_uint64 mapSize;
+  gc_int32 locked;
+  gc_int32 hugePages;
+  gc_uint8 pad[48];
+} gcX_RealtimeHeader;
+
+#ifdef _WIN32
+
+static gc_uint64 gcX_huge_page_size()
+{
+  return GetLargePageMinimum();
+}
+static void* gcX_realtime_map(gc_uint64 in_size, gc_int32 in_flags, gc_uint64* out_mapSize,
+                              gc_int32* out_locked, gc_int32* out_hugePages)
+{
+  SYSTEM_INFO info;
+  gc_uint64 pageSize;
+  void* ret = 0;
+  GetSystemInfo(&info);
+  pageSize = info.dwPageSize;
+  *out_hugePages = 0;
+  if(in_flags & GC_MEMORY_HUGE_PAGES)
+  {
+    /* Smaller buffers would waste most of a large page */
+    gc_uint64 largePageSize = s_hugePageSize;
+    if(largePageSize && in_size >= largePageSize)
+    {
+      gc_uint64 size = (in_size + largePageSize - 1) / largePageSize * largePageSize;
+      ret = VirtualAlloc(0, (SIZE_T)size, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+      if(ret)
+      {
+        /* Large pages are always resident */
+        *out_mapSize = size;
+        *out_locked = 1;
+        *out_hugePages = 1;
+        return ret;
+      }
+    }
+  }
+  *out_mapSize = (in_size + pageSize - 1) / pageSize * pageSize;
+  ret = VirtualAlloc(0, (SIZE_T)*out_mapSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+  if(!ret)
+    return 0;
+  memset(ret, 0, (size_t)*out_mapSize); /* Pre-fault */
+  *out_locked = VirtualLock(ret, (SIZE_T)*out_mapSize) ? 1 : 0;
+  return ret;
+}
+static void gcX_realtime_unmap(void* in_ptr, gc_uint64 in_mapSize, gc_int32 in_locked)
+{
+  if(in_locked)
+    VirtualUnlock(in_ptr, (SIZE_T)in_mapSize);
+  VirtualFree(in_ptr, 0, MEM_RELEASE);
+}
+
+#else
+
+static gc_uint64 gcX_huge_page_size()
+{
+  gc_uint64 ret = 0;
+#ifdef MAP_HUGETLB
+  /* The size MAP_HUGETLB maps with, e.g. "Hugepagesize:       2048 kB" */
+  char line[128];
+  unsigned long sizeKb;
+  FILE* f = fopen("/proc/meminfo", "r");
+  if(!f)
+    return 0;
+  while(fgets(line, sizeof(line), f))
+  {
+    if(sscanf(line, "Hugepagesize: %lu kB", &sizeKb) == 1)
+    {
+      ret = (gc_uint64)sizeKb * 1024;
+      break;
+    }
+  }
+  fclose(f);
+#endif /* MAP_HUGETLB */
+  return ret;
+}
+static void* gcX_realtime_map(gc_uint64 in_size, gc_int32 in_flags, gc_uint64* out_mapSize,
+                              gc_int32* out_locked, gc_int32* out_hugePages)
+{
+  gc_uint64 pageSize = (gc_uint64)sysconf(_SC_PAGESIZE);
+  void* ret = MAP_FAILED;
+  *out_hugePages = 0;
+#ifdef MAP_HUGETLB
+  /* Smaller buffers would waste most of a huge page */
+  if((in_flags & GC_MEMORY_HUGE_PAGES) && s_hugePageSize && in_size >= s_hugePageSize)
+  {
+    gc_uint64 hugePageSize = s_hugePageSize;
+    *out_mapSize = (in_size + hugePageSize - 1) / hugePageSize * hugePageSize;
+    ret = mmap(0, (size_t)*out_mapSize, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if(ret != MAP_FAILED)
+      *out_hugePages = 1;
+  }
+#endif /* MAP_HUGETLB */
+  if(ret == MAP_FAILED)
+  {
+    *out_mapSize = (in_size + pageSize - 1) / pageSize * pageSize;
+    ret = mmap(0, (size_t)*out_mapSize, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(ret == MAP_FAILED)
+      return 0;
+#ifdef MADV_HUGEPAGE
+    if(in_flags & GC_MEMORY_HUGE_PAGES)
+      madvise(ret, (size_t)*out_mapSize, MADV_HUGEPAGE); /* Transparent huge pages */
+#endif /* MADV_HUGEPAGE */
+  }
+  memset(ret, 0, (size_t)*out_mapSize); /* Pre-fault */
+  *out_locked = mlock(ret, (size_t)*out_mapSize) == 0 ? 1 : 0;
+  return ret;
+}
+static void gcX_realtime_unmap(void* in_ptr, gc_uint64 in_mapSize, gc_int32 in_locked)
+{
+  if(in_locked)
+    munlock(in_ptr, (size_t)in_mapSize);
+  munmap(in_ptr, (size_t)in_mapSize);
+}
+
+#endif /* _WIN32 */
+
+void* gc_realtime_alloc(gc_uint32 in_size)
+{
+  gcX_RealtimeHeader* header;
+  gc_uint64 mapSize;
+  gc_int32 locked, hugePages;
+  if(!(gcX_ops->realtimeMemoryFlags & GC_MEMORY_LOCKED))
+    return gcX_ops->allocFunc(in_size);
+  header = (gcX_RealtimeHeader*)gcX_realtime_map(sizeof(gcX_RealtimeHeader) + (gc_uint64)in_size,
+                                                 gcX_ops->realtimeMemoryFlags,
+                                                 &mapSize, &locked, &hugePages);
+  if(!header)
+    return 0;
+  header->mapSize = mapSize;
+  header->locked = locked;
+  header->hugePages = hugePages;
+  gc_mutex_lock(s_realtimeMutex);
+  ++s_realtimeReport.numBuffers;
+  s_realtimeReport.totalBytes += mapSize;
+  if(locked)
+    s_realtimeReport.lockedBytes += mapSize;
+  if(hugePages)
+    s_realtimeReport.hugePageBytes += mapSize;
+  gc_mutex_unlock(s_realtimeMutex);
+  return header + 1;
+}
+void gc_realtime_free(void* in_ptr)
+{
+  gcX_RealtimeHeader* header;
+  gc_uint64 mapSize;
+  gc_int32 locked;
+  if(!(gcX_ops->realtimeMemoryFlags & GC_MEMORY_LOCKED))
+  {
+    gcX_ops->freeFunc(in_ptr);
+    return;
+  }
+  if(!in_ptr)
+    return;
+  header = (gcX_RealtimeHeader*)in_ptr - 1;
+  mapSize = header->mapSize;
+  locked = header->locked;
+  gc_mutex_lock(s_realtimeMutex);
+  --s_realtimeReport.numBuffers;
+  s_realtimeReport.totalBytes -= mapSize;
+  if(locked)
+    s_realtimeReport.lockedBytes -= mapSize;
+  if(header->hugePages)
+    s_realtimeReport.hugePageBytes -= mapSize;
+  gc_mutex_unlock(s_realtimeMutex);
+  gcX_realtime_unmap(header, mapSize, locked);
+}
+void gc_realtime_report(gc_MemoryReport* out_report)
+{
+  gc_mutex_lock(s_realtimeMutex);
+  memcpy(out_report, &s_realtimeReport, sizeof(gc_MemoryReport));
+  gc_mutex_unlock(s_realtimeMutex);
+}
+
+/* Real-Time Safety Violations */
+#define GCX_REALTIME_MAX_SITES 64
+
+/* Lock-free (recording must not itself block the real-time thread) */
+typedef struct gcX_RealtimeSite {
+  void* volatile callSite;
+  volatile gc_int32 type;
+  volatile gc_int32 count;
+} gcX_RealtimeSite;
+
+static gcX_RealtimeSite s_realtimeSites[GCX_REALTIME_MAX_SITES];
+static volatile gc_int32 s_realtimeViolations = 0;
+
+void gcX_realtime_violation(gc_int32 in_type, void* in_callSite)
+{
+  gc_int32 i;
+  gc_atomic_add(&s_realtimeViolations, 1);
+  for(i = 0; i < GCX_REALTIME_MAX_SITES; ++i)
+  {
+    gcX_RealtimeSite* site = &s_realtimeSites[i];
+    void* callSite = gc_atomic_load_ptr(&site->callSite);
+    if(!callSite)
+      callSite = gc_atomic_cas_ptr(&site->callSite, 0, in_callSite);
+    if(!callSite || callSite == in_callSite)
+    {
+      site->type = in_type;
+      gc_atomic_add(&site->count, 1);
+      break;
+    }
+  }
+  /* Sites beyond the table capacity are only reflected in the total */
+  if(gcX_ops->realtimeCheckMode == GC_REALTIME_CHECK_TRAP)
+  {
+    fprintf(stderr, "Gorilla: real-time violation (type %d) at %p\n", (int)in_type, in_callSite);
+    abort();
+  }
+}
+gc_int32 gc_realtime_violations(gc_RealtimeViolation* out_violations, gc_int32 in_max)
+{
+  gc_int32 i;
+  gc_int32 numOut = 0;
+  for(i = 0; i < GCX_REALTIME_MAX_SITES && numOut < in_max; ++i)
+  {
+    gcX_RealtimeSite* site = &s_realtimeSites[i];
+    void* callSite = gc_atomic_load_ptr(&site->callSite);
+    if(!callSite)
+      break;
+    out_violations[numOut].type = site->type;
+    out_violations[numOut].callSite = callSite;
+    out_violations[numOut].count = site->count;
+    ++numOut;
+  }
+  for(; numOut < in_max; ++numOut)
+  {
+    out_violations[numOut].type = 0;
+    out_violations[numOut].callSite = 0;
+    out_violations[numOut].count = 0;
+  }
+  return gc_atomic_add(&s_realtimeViolations, 0);
+}
+void gc_realtime_reset()
+{
+  memset(s_realtimeSites, 0, sizeof(s_realtimeSites));
+  s_realtimeViolations = 0;
+}
+
 /* Circular Buffer Functions */
 gc_CircBuffer* gc_buffer_create(gc_uint32 in_size)
 {
@@ -41,27 +353,175 @@ gc_CircBuffer* gc_buffer_create(gc_uint32 in_size)
   if(!in_size || (in_size & (in_size - 1))) /* Must be power-of-two*/
     return 0;
   ret = gcX_ops->allocFunc(sizeof(gc_CircBuffer));
-  ret->data = gcX_ops->allocFunc(in_size);
+  ret->data = gc_realtime_alloc(in_size);
   ret->dataSize = in_size;
+  ret->mirrored = 0;
+  ret->mirrorLocked = 0;
+  ret->nextAvail = 0;
+  ret->nextFree = 0;
+  return ret;
+}
+
+#ifdef _WIN32
+
+static gc_uint8* gcX_buffer_map_mirrored(gc_uint32 in_size)
+{
+  SYSTEM_INFO info;
+  HANDLE mapping;
+  gc_uint8* ret = 0;
+  gc_int32 attempt;
+  GetSystemInfo(&info);
+  if(in_size % info.dwAllocationGranularity)
+    return 0;
+  mapping = CreateFileMapping(INVALID_HANDLE_VALUE, 0, PAGE_READWRITE, 0, in_size, 0);
+  if(!mapping)
+    return 0;
+  /* Find a free range for both views. Another thread may grab the range
+     between the VirtualFree() and the mapping, so retry a few times. */
+  for(attempt = 0; attempt < 8 && !ret; ++attempt)
+  {
+    gc_uint8* addr = (gc_uint8*)VirtualAlloc(0, (SIZE_T)in_size * 2, MEM_RESERVE, PAGE_NOACCESS);
+    gc_uint8* lower;
+    gc_uint8* upper;
+    if(!addr)
+      break;
+    VirtualFree(addr, 0, MEM_RELEASE);
+    lower = (gc_uint8*)MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, in_size, addr);
+    upper = lower ? (gc_uint8*)MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, in_size, addr + in_size) : 0;
+    if(lower && upper)
+      ret = lower;
+    else if(lower)
+      UnmapViewOfFile(lower);
+  }
+  CloseHandle(mapping); /* The views keep the mapping alive */
+  return ret;
+}
+static void gcX_buffer_unmap_mirrored(gc_uint8* in_data, gc_uint32 in_size)
+{
+  UnmapViewOfFile(in_data + in_size);
+  UnmapViewOfFile(in_data);
+}
+
+#else
+
+static gc_uint8* gcX_buffer_map_mirrored(gc_uint32 in_size)
+{
+  gc_uint8* ret;
+  int fd = -1;
+  if(in_size % (gc_uint32)sysconf(_SC_PAGESIZE))
+    return 0;
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+  fd = memfd_create("gc_CircBuffer", MFD_CLOEXEC);
+#endif /* __linux__ */
+  if(fd < 0)
+  {
+    /* Anonymous shared memory object, unlinked as soon as it is opened */
+    char name[64];
+    sprintf(name, "/gc_CircBuffer.%d.%p", (int)getpid(), (void*)&fd);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if(fd < 0)
+      return 0;
+    shm_unlink(name);
+  }
+  if(ftruncate(fd, in_size) != 0)
+  {
+    close(fd);
+    return 0;
+  }
+  /* Reserve the whole range, then map the same pages over both halves */
+  ret = (gc_uint8*)mmap(0, (size_t)in_size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(ret != MAP_FAILED &&
+     (mmap(ret, in_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+      mmap(ret + in_size, in_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED))
+  {
+    munmap(ret, (size_t)in_size * 2);
+    ret = MAP_FAILED;
+  }
+  close(fd); /* The mappings keep the memory alive */
+  return ret == MAP_FAILED ? 0 : ret;
+}
+static void gcX_buffer_unmap_mirrored(gc_uint8* in_data, gc_uint32 in_size)
+{
+  munmap(in_data, (size_t)in_size * 2);
+}
+
+#endif /* _WIN32 */
+
+gc_CircBuffer* gc_buffer_create_mirrored(gc_uint32 in_size)
+{
+  gc_CircBuffer* ret;
+  gc_uint8* data;
+  gc_int32 locked = 0;
+  if(!in_size || (in_size & (in_size - 1))) /* Must be power-of-two*/
+    return 0;
+  data = gcX_buffer_map_mirrored(in_size);
+  if(!data)
+    return gc_buffer_create(in_size);
+  memset(data, 0, in_size); /* Pre-fault */
+  if(gcX_ops->realtimeMemoryFlags & GC_MEMORY_LOCKED)
+  {
+    /* Both views share the same physical pages, so they are reported once */
+#ifdef _WIN32
+    locked = VirtualLock(data, in_size) ? 1 : 0;
+#else
+    locked = mlock(data, in_size) == 0 ? 1 : 0;
+#endif /* _WIN32 */
+    gc_mutex_lock(s_realtimeMutex);
+    ++s_realtimeReport.numBuffers;
+    s_realtimeReport.totalBytes += in_size;
+    if(locked)
+      s_realtimeReport.lockedBytes += in_size;
+    gc_mutex_unlock(s_realtimeMutex);
+  }
+  ret = gcX_ops->allocFunc(sizeof(gc_CircBuffer));
+  ret->data = data;
+  ret->dataSize = in_size;
+  ret->mirrored = 1;
+  ret->mirrorLocked = locked;
   ret->nextAvail = 0;
   ret->nextFree = 0;
   return ret;
 }
 gc_result gc_buffer_destroy(gc_CircBuffer* in_buffer)
 {
-  gcX_ops->freeFunc(in_buffer->data);
+  if(in_buffer->mirrored)
+  {
+    if(gcX_ops->realtimeMemoryFlags & GC_MEMORY_LOCKED)
+    {
+      gc_mutex_lock(s_realtimeMutex);
+      --s_realtimeReport.numBuffers;
+      s_realtimeReport.totalBytes -= in_buffer->dataSize;
+      if(in_buffer->mirrorLocked)
+        s_realtimeReport.lockedBytes -= in_buffer->dataSize;
+      gc_mutex_unlock(s_realtimeMutex);
+    }
+    gcX_buffer_unmap_mirrored(in_buffer->data, in_buffer->dataSize);
+  }
+  else
+    gc_realtime_free(in_buffer->data);
   gcX_ops->freeFunc(in_buffer);
   return GC_SUCCESS;
 }
+static gc_uint32 gcX_buffer_loadAvail(gc_CircBuffer* in_buffer)
+{
+  return (gc_uint32)gc_atomic_load((volatile gc_int32*)&in_buffer->nextAvail);
+}
+static gc_uint32 gcX_buffer_loadFree(gc_CircBuffer* in_buffer)
+{
+  return (gc_uint32)gc_atomic_load((volatile gc_int32*)&in_buffer->nextFree);
+}
 gc_uint32 gc_buffer_bytesAvail(gc_CircBuffer* in_buffer)
 {
-  /* producer/consumer call (all race-induced errors should be tolerable) */
-  return in_buffer->nextFree - in_buffer->nextAvail;
+  /* producer/consumer call (the result is exact for the calling side: the
+     producer may only see fewer free bytes, the consumer fewer avail bytes) */
+  gc_uint32 nextAvail = gcX_buffer_loadAvail(in_buffer);
+  return gcX_buffer_loadFree(in_buffer) - nextAvail;
 }
 gc_uint32 gc_buffer_bytesFree(gc_CircBuffer* in_buffer)
 {
-  /* producer/consumer call (all race-induced errors should be tolerable) */
-  return in_buffer->dataSize - gc_buffer_bytesAvail(in_buffer);
+  /* producer/consumer call */
+  gc_uint32 nextFree = gcX_buffer_loadFree(in_buffer);
+  return in_buffer->dataSize - (nextFree - gcX_buffer_loadAvail(in_buffer));
 }
 gc_int32 gc_buffer_getFree(gc_CircBuffer* in_buffer, gc_uint32 in_numBytes,
                            void** out_dataA, gc_uint32* out_sizeA,
@@ -71,11 +531,10 @@ gc_int32 gc_buffer_getFree(gc_CircBuffer* in_buffer, gc_uint32 in_numBytes,
   gc_CircBuffer* b = in_buffer;
   gc_uint32 size = b->dataSize;
   gc_uint32 nextFree = b->nextFree % size;
-  gc_uint32 nextAvail = b->nextAvail % size;
   gc_uint32 maxBytes = size - nextFree;
   if(in_numBytes > gc_buffer_bytesFree(b))
     return -1;
-  if(maxBytes >= in_numBytes)
+  if(maxBytes >= in_numBytes || b->mirrored)
   {
     *out_dataA = &b->data[nextFree];
     *out_sizeA = in_numBytes;
@@ -99,18 +558,17 @@ gc_result gc_buffer_write(gc_CircBuffer* in_buffer, void* in_data,
   gc_CircBuffer* b = in_buffer;
   gc_uint32 size = b->dataSize;
   gc_uint32 nextFree = b->nextFree % size;
-  gc_uint32 nextAvail = b->nextAvail % size;
   gc_uint32 maxBytes = size - nextFree;
   if(in_numBytes > gc_buffer_bytesFree(b))
     return GC_ERROR_GENERIC;
-  if(maxBytes >= in_numBytes)
+  if(maxBytes >= in_numBytes || b->mirrored)
     memcpy(&b->data[nextFree], in_data, in_numBytes);
   else
   {
     memcpy(&b->data[nextFree], in_data, maxBytes);
     memcpy(&b->data[0], (char*)in_data + maxBytes, in_numBytes - maxBytes);
   }
-  b->nextFree += in_numBytes;
+  gc_buffer_produce(b, in_numBytes);
   return GC_SUCCESS;
 }
 gc_int32 gc_buffer_getAvail(gc_CircBuffer* in_buffer, gc_uint32 in_numBytes,
@@ -121,12 +579,11 @@ gc_int32 gc_buffer_getAvail(gc_CircBuffer* in_buffer, gc_uint32 in_numBytes,
   gc_CircBuffer* b = in_buffer;
   gc_uint32 bytesAvailable = gc_buffer_bytesAvail(in_buffer);
   gc_uint32 size = b->dataSize;
-  gc_uint32 nextFree = b->nextFree % size;
   gc_uint32 nextAvail = b->nextAvail % size;
   gc_uint32 maxBytes = size - nextAvail;
   if(bytesAvailable < in_numBytes)
     return -1;
-  if(maxBytes >= in_numBytes)
+  if(maxBytes >= in_numBytes || b->mirrored)
   {
     *out_dataA = &b->data[nextAvail];
     *out_sizeA = in_numBytes;
@@ -161,14 +618,215 @@ void gc_buffer_read(gc_CircBuffer* in_buffer, void* in_data,
 }
 void gc_buffer_produce(gc_CircBuffer* in_buffer, gc_uint32 in_numBytes)
 {
-  /* producer-only call */
-  in_buffer->nextFree += in_numBytes;
+  /* producer-only call (publishes the written bytes to the consumer) */
+  gc_atomic_store((volatile gc_int32*)&in_buffer->nextFree, (gc_int32)(in_buffer->nextFree + in_numBytes));
 }
 
 void gc_buffer_consume(gc_CircBuffer* in_buffer, gc_uint32 in_numBytes)
 {
-  /* consumer-only call */
-  in_buffer->nextAvail += in_numBytes;
+  /* consumer-only call (hands the read bytes back to the producer) */
+  gc_atomic_store((volatile gc_int32*)&in_buffer->nextAvail, (gc_int32)(in_buffer->nextAvail + in_numBytes));
+}
+gc_uint32 gc_buffer_unconsume(gc_CircBuffer* in_buffer, gc_uint32 in_numBytes)
+{
+  /* consumer-only call; the producer may be filling, so nextFree only grows */
+  gc_uint32 nextFree = (gc_uint32)gc_atomic_load((volatile gc_int32*)&in_buffer->nextFree);
+  gc_uint32 maxBytes = in_buffer->dataSize - (nextFree - in_buffer->nextAvail);
+  in_numBytes = in_numBytes > maxBytes ? maxBytes : in_numBytes;
+  gc_atomic_store((volatile gc_int32*)&in_buffer->nextAvail, (gc_int32)(in_buffer->nextAvail - in_numBytes));
+  return in_numBytes;
+}
+
+/* Mapped File Functions */
+/* Largest mappable file: 2 GB on 32-bit targets, unlimited on 64-bit ones */
+#define GCX_MAP_MAX ((gc_int64)((size_t)-1 >> 1))
+#ifdef _WIN32
+
+gc_MappedFile* gc_file_map(const char* in_filename)
+{
+  gc_MappedFile* ret;
+  LARGE_INTEGER size;
+  HANDLE mapping = 0;
+  void* data = 0;
+  HANDLE file = CreateFileA(in_filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, 0);
+  if(file == INVALID_HANDLE_VALUE)
+    return 0;
+  if(!GetFileSizeEx(file, &size) || size.QuadPart > GCX_MAP_MAX)
+  {
+    CloseHandle(file);
+    return 0;
+  }
+  if(size.QuadPart)
+  {
+    mapping = CreateFileMapping(file, 0, PAGE_READONLY, 0, 0, 0);
+    data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : 0;
+  }
+  CloseHandle(file); /* The mapping keeps the file open */
+  if(size.QuadPart && !data)
+  {
+    if(mapping)
+      CloseHandle(mapping);
+    return 0;
+  }
+  ret = gcX_ops->allocFunc(sizeof(gc_MappedFile));
+  ret->data = data;
+  ret->size = size.QuadPart;
+  ret->handle = mapping;
+  return ret;
+}
+void gc_file_unmap(gc_MappedFile* in_file)
+{
+  if(in_file->data)
+  {
+    UnmapViewOfFile(in_file->data);
+    CloseHandle((HANDLE)in_file->handle);
+  }
+  gcX_ops->freeFunc(in_file);
+}
+static void* gcX_file_open(const char* in_filename, gc_int64* out_size)
+{
+  LARGE_INTEGER size;
+  HANDLE file = CreateFileA(in_filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, 0);
+  if(file == INVALID_HANDLE_VALUE)
+    return 0;
+  if(!GetFileSizeEx(file, &size))
+  {
+    CloseHandle(file);
+    return 0;
+  }
+  *out_size = (gc_int64)size.QuadPart;
+  return file;
+}
+static gc_int32 gcX_file_read_at(void* in_handle, void* in_dst, gc_int32 in_numBytes, gc_int64 in_offset)
+{
+  /* A synchronous ReadFile() with an explicit offset is the pread() equivalent */
+  OVERLAPPED ov;
+  DWORD numRead = 0;
+  memset(&ov, 0, sizeof(OVERLAPPED));
+  ov.Offset = (DWORD)(in_offset & 0xffffffff);
+  ov.OffsetHigh = (DWORD)(in_offset >> 32);
+  if(!ReadFile((HANDLE)in_handle, in_dst, (DWORD)in_numBytes, &numRead, &ov))
+    return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+  return (gc_int32)numRead;
+}
+static void gcX_file_close(void* in_handle)
+{
+  CloseHandle((HANDLE)in_handle);
+}
+
+#else
+
+#include <sys/stat.h>
+#include <errno.h>
+
+gc_MappedFile* gc_file_map(const char* in_filename)
+{
+  gc_MappedFile* ret;
+  struct stat st;
+  void* data = 0;
+  int fd = open(in_filename, O_RDONLY);
+  if(fd < 0)
+    return 0;
+  if(fstat(fd, &st) != 0 || (gc_int64)st.st_size > GCX_MAP_MAX)
+  {
+    close(fd);
+    return 0;
+  }
+  if(st.st_size)
+  {
+    data = mmap(0, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if(data == MAP_FAILED)
+    {
+      close(fd);
+      return 0;
+    }
+  }
+  close(fd); /* The mapping keeps the file open */
+  ret = gcX_ops->allocFunc(sizeof(gc_MappedFile));
+  ret->data = data;
+  ret->size = (gc_int64)st.st_size;
+  ret->handle = 0;
+  return ret;
+}
+void gc_file_unmap(gc_MappedFile* in_file)
+{
+  if(in_file->data)
+    munmap(in_file->data, (size_t)in_file->size);
+  gcX_ops->freeFunc(in_file);
+}
+static void* gcX_file_open(const char* in_filename, gc_int64* out_size)
+{
+  struct stat st;
+  int fd = open(in_filename, O_RDONLY);
+  if(fd < 0)
+    return 0;
+  if(fstat(fd, &st) != 0)
+  {
+    close(fd);
+    return 0;
+  }
+  *out_size = (gc_int64)st.st_size;
+  return (void*)(size_t)(fd + 1); /* Keep 0 free to signal failure */
+}
+static gc_int32 gcX_file_read_at(void* in_handle, void* in_dst, gc_int32 in_numBytes, gc_int64 in_offset)
+{
+  int fd = (int)(size_t)in_handle - 1;
+  ssize_t numRead;
+  do
+    numRead = pread(fd, in_dst, (size_t)in_numBytes, (off_t)in_offset);
+  while(numRead < 0 && errno == EINTR);
+  return (gc_int32)numRead;
+}
+static void gcX_file_close(void* in_handle)
+{
+  close((int)(size_t)in_handle - 1);
+}
+
+#endif /* _WIN32 */
+
+/* Shared File Functions */
+gc_File* gc_file_open(const char* in_filename)
+{
+  gc_File* ret;
+  gc_int64 size = 0;
+  void* handle = gcX_file_open(in_filename, &size);
+  if(!handle)
+    return 0;
+  ret = gcX_ops->allocFunc(sizeof(gc_File));
+  ret->handle = handle;
+  ret->size = size;
+  ret->refCount = 1;
+  return ret;
+}
+gc_int32 gc_file_read_at(gc_File* in_file, void* in_dst, gc_int32 in_numBytes, gc_int64 in_offset)
+{
+  /* Positional reads may return short; keep going until EOF or error */
+  gc_int32 total = 0;
+  while(total < in_numBytes)
+  {
+    gc_int32 numRead = gcX_file_read_at(in_file->handle, (char*)in_dst + total,
+                                        in_numBytes - total, in_offset + total);
+    if(numRead < 0)
+      return total ? total : -1;
+    if(numRead == 0)
+      break;
+    total += numRead;
+  }
+  return total;
+}
+void gc_file_acquire(gc_File* in_file)
+{
+  gc_atomic_add(&in_file->refCount, 1);
+}
+void gc_file_release(gc_File* in_file)
+{
+  if(gc_atomic_add(&in_file->refCount, -1) == 0)
+  {
+    gcX_file_close(in_file->handle);
+    gcX_ops->freeFunc(in_file);
+  }
 }
 
 /* List Functions */
@@ -193,3 +851,53 @@ void gc_list_unlink(gc_Link* in_link)
   in_link->next = 0;
   in_link->data = 0;
 }
+
+/* Queue Functions */
+void gc_queue_init(gc_Queue* in_queue)
+{
+  in_queue->stub.next = 0;
+  in_queue->stub.data = 0;
+  in_queue->head = &in_queue->stub;
+  in_queue->tail = &in_queue->stub;
+}
+void gc_queue_push(gc_Queue* in_queue, gc_QueueNode* in_node, void* in_data)
+{
+  /* producer call (any thread) */
+  gc_QueueNode* prev;
+  in_node->data = in_data;
+  in_node->next = 0;
+  prev = (gc_QueueNode*)gc_atomic_exchange_ptr((void* volatile*)&in_queue->head, in_node);
+  gc_atomic_store_ptr((void* volatile*)&prev->next, in_node);
+}
+gc_QueueNode* gc_queue_pop(gc_Queue* in_queue)
+{
+  /* consumer-only call */
+  gc_Queue* q = in_queue;
+  gc_QueueNode* tail = q->tail;
+  gc_QueueNode* next = (gc_QueueNode*)gc_atomic_load_ptr((void* volatile*)&tail->next);
+  gc_QueueNode* head;
+  if(tail == &q->stub)
+  {
+    if(!next)
+      return 0;
+    q->tail = next;
+    tail = next;
+    next = (gc_QueueNode*)gc_atomic_load_ptr((void* volatile*)&next->next);
+  }
+  if(next)
+  {
+    q->tail = next;
+    return tail;
+  }
+  head = (gc_QueueNode*)gc_atomic_load_ptr((void* volatile*)&q->head);
+  if(tail != head)
+    return 0; /* A producer is mid-push; its node will be visible next call */
+  gc_queue_push(q, &q->stub, 0);
+  next = (gc_QueueNode*)gc_atomic_load_ptr((void* volatile*)&tail->next);
+  if(next)
+  {
+    q->tail = next;
+    return tail;
+  }
+  return 0;
+}
@@ -1,3 +1,7 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* pthread_attr_setaffinity_np() */
+#endif /* __linux__ */
+
 #include "gorilla/common/gc_common.h"
 
 #include "gorilla/common/gc_thread.h"
@@ -7,6 +11,30 @@
 #include <string.h>
 
 /* Thread Functions */
+void gc_thread_params_default(gc_ThreadParams* out_params)
+{
+  out_params->priority = GC_THREAD_PRIORITY_NORMAL;
+  out_params->schedPolicy = GC_THREAD_SCHED_DEFAULT;
+  out_params->stackSize = 0;
+  out_params->affinityMask = 0;
+}
+static gc_int32 gcX_thread_params_valid(gc_ThreadParams* in_params)
+{
+  /* The priority indexes the platform lookup tables */
+  return in_params->priority >= GC_THREAD_PRIORITY_NORMAL &&
+         in_params->priority <= GC_THREAD_PRIORITY_HIGHEST &&
+         in_params->schedPolicy >= GC_THREAD_SCHED_DEFAULT &&
+         in_params->schedPolicy <= GC_THREAD_SCHED_RR;
+}
+gc_Thread* gc_thread_create(gc_ThreadFunc in_threadFunc, void* in_context,
+                            gc_int32 in_priority, gc_int32 in_stackSize)
+{
+  gc_ThreadParams params;
+  gc_thread_params_default(&params);
+  params.priority = in_priority;
+  params.stackSize = in_stackSize;
+  return gc_thread_create_custom(in_threadFunc, in_context, &params);
+}
 
 #ifdef _WIN32
 
@@ -17,17 +45,32 @@ static gc_int32 priorityLut[] = {
   0, -1, 1, 2
 };
 
-gc_Thread* gc_thread_create(gc_ThreadFunc in_threadFunc, void* in_context,
-                            gc_int32 in_priority, gc_int32 in_stackSize)
+gc_Thread* gc_thread_create_custom(gc_ThreadFunc in_threadFunc, void* in_context,
+                                   gc_ThreadParams* in_params)
 {
-  gc_Thread* ret = gcX_ops->allocFunc(sizeof(gc_Thread));
+  gc_ThreadParams params;
+  gc_Thread* ret;
+  gc_int32 priority;
+  if(in_params)
+    params = *in_params;
+  else
+    gc_thread_params_default(&params);
+  if(!gcX_thread_params_valid(&params))
+    return 0;
+  ret = gcX_ops->allocFunc(sizeof(gc_Thread));
   ret->threadObj = gcX_ops->allocFunc(sizeof(HANDLE));
   ret->threadFunc = in_threadFunc;
   ret->context = in_context;
-  ret->priority = in_priority;
-  ret->stackSize = in_stackSize;
-  *(HANDLE*)ret->threadObj = CreateThread(0, in_stackSize, (LPTHREAD_START_ROUTINE)in_threadFunc, in_context, CREATE_SUSPENDED, (LPDWORD)&ret->id);
-  SetThreadPriority(*(HANDLE*)ret->threadObj, priorityLut[in_priority]);
+  ret->priority = params.priority;
+  ret->stackSize = params.stackSize;
+  ret->schedPolicy = params.schedPolicy;
+  ret->affinityMask = params.affinityMask;
+  *(HANDLE*)ret->threadObj = CreateThread(0, params.stackSize, (LPTHREAD_START_ROUTINE)in_threadFunc, in_context, CREATE_SUSPENDED, (LPDWORD)&ret->id);
+  /* Windows has no real-time policy for threads; time-critical is the closest */
+  priority = params.schedPolicy == GC_THREAD_SCHED_DEFAULT ? priorityLut[params.priority] : THREAD_PRIORITY_TIME_CRITICAL;
+  SetThreadPriority(*(HANDLE*)ret->threadObj, priority);
+  if(params.affinityMask)
+    SetThreadAffinityMask(*(HANDLE*)ret->threadObj, (DWORD_PTR)params.affinityMask);
   return ret;
 }
 void gc_thread_run(gc_Thread* in_thread)
@@ -52,9 +95,18 @@ void gc_thread_destroy(gc_Thread* in_thread)
 #elif defined(__linux__) || defined(__APPLE__)
 #include <pthread.h>
 #include <sched.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/resource.h>
 
+/* Nice values for GC_THREAD_SCHED_DEFAULT (negative values need privileges) */
 static gc_int32 priorityLut[] = {
-  0, -10, 10, 19
+  0, 10, -5, -10
+};
+
+/* Quarters of the real-time priority range for the real-time policies */
+static gc_int32 rtPriorityLut[] = {
+  2, 1, 3, 4
 };
 
 typedef struct LinuxThreadData {
@@ -63,44 +115,111 @@ typedef struct LinuxThreadData {
   pthread_mutex_t suspendMutex;
   gc_ThreadFunc threadFunc;
   void* context;
+  gc_int32 nice;
 } LinuxThreadData;
 
 static void* StaticThreadWrapper(void* in_context)
 {
   LinuxThreadData* threadData = (LinuxThreadData*)in_context;
   pthread_mutex_lock(&threadData->suspendMutex);
+#ifdef __linux__
+  /* On Linux, PRIO_PROCESS with an id of 0 only affects the calling thread */
+  if(threadData->nice)
+    setpriority(PRIO_PROCESS, 0, threadData->nice); /* Failure leaves the default */
+#endif /* __linux__ */
   threadData->threadFunc(threadData->context);
   pthread_mutex_unlock(&threadData->suspendMutex);
   return 0;
 }
 
-gc_Thread* gc_thread_create(gc_ThreadFunc in_threadFunc, void* in_context,
-                            gc_int32 in_priority, gc_int32 in_stackSize)
+static void gcX_thread_attr_init(LinuxThreadData* in_threadData, gc_ThreadParams* in_params,
+                                 gc_int32 in_schedPolicy)
+{
+  pthread_attr_t* attr = &in_threadData->attr;
+  pthread_attr_init(attr);
+  if(in_params->stackSize > 0)
+  {
+    size_t stackSize = (size_t)in_params->stackSize;
+    stackSize = stackSize < (size_t)PTHREAD_STACK_MIN ? (size_t)PTHREAD_STACK_MIN : stackSize;
+    pthread_attr_setstacksize(attr, stackSize);
+  }
+  if(in_schedPolicy != GC_THREAD_SCHED_DEFAULT)
+  {
+    struct sched_param param;
+    int policy = in_schedPolicy == GC_THREAD_SCHED_RR ? SCHED_RR : SCHED_FIFO;
+    int minPrio = sched_get_priority_min(policy);
+    int maxPrio = sched_get_priority_max(policy);
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = minPrio + (maxPrio - minPrio) * rtPriorityLut[in_params->priority] / 4;
+    pthread_attr_setinheritsched(attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(attr, policy);
+    pthread_attr_setschedparam(attr, &param);
+  }
+#ifdef __linux__
+  if(in_params->affinityMask)
+  {
+    cpu_set_t cpuSet;
+    gc_int32 i;
+    CPU_ZERO(&cpuSet);
+    for(i = 0; i < 64 && i < CPU_SETSIZE; ++i)
+    {
+      if(in_params->affinityMask & ((gc_uint64)1 << i))
+        CPU_SET(i, &cpuSet);
+    }
+    pthread_attr_setaffinity_np(attr, sizeof(cpuSet), &cpuSet);
+  }
+#endif /* __linux__ */
+}
+
+gc_Thread* gc_thread_create_custom(gc_ThreadFunc in_threadFunc, void* in_context,
+                                   gc_ThreadParams* in_params)
 {
   int result = 0;
-  struct sched_param param;
-  gc_Thread* ret = gcX_ops->allocFunc(sizeof(gc_Thread));
-  LinuxThreadData* threadData = (LinuxThreadData*)gcX_ops->allocFunc(sizeof(LinuxThreadData));
+  gc_ThreadParams params;
+  gc_Thread* ret;
+  LinuxThreadData* threadData;
+  if(in_params)
+    params = *in_params;
+  else
+    gc_thread_params_default(&params);
+  if(!gcX_thread_params_valid(&params))
+    return 0;
+  ret = gcX_ops->allocFunc(sizeof(gc_Thread));
+  threadData = (LinuxThreadData*)gcX_ops->allocFunc(sizeof(LinuxThreadData));
   threadData->threadFunc = in_threadFunc;
   threadData->context = in_context;
+  threadData->nice = params.schedPolicy == GC_THREAD_SCHED_DEFAULT ? priorityLut[params.priority] : 0;
   
   ret->threadObj = threadData;
   ret->threadFunc = in_threadFunc;
   ret->context = in_context;
-  ret->priority = in_priority;
-  ret->stackSize = in_stackSize;
+  ret->priority = params.priority;
+  ret->stackSize = params.stackSize;
+  ret->schedPolicy = params.schedPolicy;
+  ret->affinityMask = params.affinityMask;
   
   pthread_mutex_init(&threadData->suspendMutex, NULL);
   pthread_mutex_lock(&threadData->suspendMutex);
   
-  result = pthread_attr_init(&threadData->attr);
-  #ifdef __APPLE__
-  param.sched_priority = priorityLut[in_priority];
-  #elif defined(__linux__)
-  param.__sched_priority = priorityLut[in_priority];
-  #endif /* __APPLE__ */
-  pthread_attr_setschedparam(&threadData->attr, &param);
-  pthread_create(&threadData->thread, &threadData->attr, StaticThreadWrapper, threadData);
+  gcX_thread_attr_init(threadData, &params, params.schedPolicy);
+  result = pthread_create(&threadData->thread, &threadData->attr, StaticThreadWrapper, threadData);
+  if(result != 0 && params.schedPolicy != GC_THREAD_SCHED_DEFAULT)
+  {
+    /* Not permitted to use a real-time policy; fall back to the default */
+    pthread_attr_destroy(&threadData->attr);
+    gcX_thread_attr_init(threadData, &params, GC_THREAD_SCHED_DEFAULT);
+    ret->schedPolicy = GC_THREAD_SCHED_DEFAULT;
+    result = pthread_create(&threadData->thread, &threadData->attr, StaticThreadWrapper, threadData);
+  }
+  if(result != 0)
+  {
+    pthread_attr_destroy(&threadData->attr);
+    pthread_mutex_unlock(&threadData->suspendMutex);
+    pthread_mutex_destroy(&threadData->suspendMutex);
+    gcX_ops->freeFunc(threadData);
+    gcX_ops->freeFunc(ret);
+    return 0;
+  }
   
   return ret;
 }
@@ -122,14 +241,33 @@ void gc_thread_destroy(gc_Thread* in_thread)
 {
   LinuxThreadData* threadData = (LinuxThreadData*)in_thread->threadObj;
   pthread_mutex_destroy(&threadData->suspendMutex);
-  pthread_exit(&threadData->thread);
   pthread_attr_destroy(&threadData->attr);
+  gcX_ops->freeFunc(threadData);
+  gcX_ops->freeFunc(in_thread);
 }
 
 #else
 #error Thread class not yet defined for this platform
 #endif /* _WIN32 */
 
+/* Real-Time Thread Marking */
+#ifdef _MSC_VER
+static __declspec(thread) gc_int32 s_realtimeThread = 0;
+#else
+static __thread gc_int32 s_realtimeThread = 0;
+#endif /* _MSC_VER */
+
+gc_int32 gc_realtime_thread_set(gc_int32 in_realtime)
+{
+  gc_int32 ret = s_realtimeThread;
+  s_realtimeThread = in_realtime;
+  return ret;
+}
+gc_int32 gc_realtime_thread_get()
+{
+  return s_realtimeThread;
+}
+
 /* Mutex Functions */
 
 #ifdef _WIN32
@@ -137,12 +275,10 @@ void gc_thread_destroy(gc_Thread* in_thread)
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 
-gc_Mutex* gc_mutex_create()
+static void gcX_mutex_init(gc_Mutex* in_mutex)
 {
-  gc_Mutex* ret = gcX_ops->allocFunc(sizeof(gc_Mutex));
-  ret->mutex = gcX_ops->allocFunc(sizeof(CRITICAL_SECTION));
-  InitializeCriticalSection((CRITICAL_SECTION*)ret->mutex);
-  return ret;
+  in_mutex->mutex = gcX_ops->allocFunc(sizeof(CRITICAL_SECTION));
+  InitializeCriticalSection((CRITICAL_SECTION*)in_mutex->mutex);
 }
 void gc_mutex_destroy(gc_Mutex* in_mutex)
 {
@@ -150,7 +286,11 @@ void gc_mutex_destroy(gc_Mutex* in_mutex)
   gcX_ops->freeFunc(in_mutex->mutex);
   gcX_ops->freeFunc(in_mutex);
 }
-void gc_mutex_lock(gc_Mutex* in_mutex)
+static gc_int32 gcX_mutex_try(gc_Mutex* in_mutex)
+{
+  return TryEnterCriticalSection((CRITICAL_SECTION*)in_mutex->mutex) ? 1 : 0;
+}
+static void gcX_mutex_wait(gc_Mutex* in_mutex)
 {
   EnterCriticalSection((CRITICAL_SECTION*)in_mutex->mutex);
 }
@@ -158,17 +298,23 @@ void gc_mutex_unlock(gc_Mutex* in_mutex)
 {
   LeaveCriticalSection((CRITICAL_SECTION*)in_mutex->mutex);
 }
+gc_uint64 gc_time_ns()
+{
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&count);
+  return (gc_uint64)((gc_float64)count.QuadPart * 1000000000.0 / (gc_float64)freq.QuadPart);
+}
 
 #elif defined(__linux__) || defined(__APPLE__)
 
 #include <pthread.h>
+#include <time.h>
 
-gc_Mutex* gc_mutex_create()
+static void gcX_mutex_init(gc_Mutex* in_mutex)
 {
-  gc_Mutex* ret = gcX_ops->allocFunc(sizeof(gc_Mutex));
-  ret->mutex = gcX_ops->allocFunc(sizeof(pthread_mutex_t));
-  pthread_mutex_init((pthread_mutex_t*)ret->mutex, NULL);
-  return ret;
+  in_mutex->mutex = gcX_ops->allocFunc(sizeof(pthread_mutex_t));
+  pthread_mutex_init((pthread_mutex_t*)in_mutex->mutex, NULL);
 }
 void gc_mutex_destroy(gc_Mutex* in_mutex)
 {
@@ -176,7 +322,11 @@ void gc_mutex_destroy(gc_Mutex* in_mutex)
   gcX_ops->freeFunc(in_mutex->mutex);
   gcX_ops->freeFunc(in_mutex);
 }
-void gc_mutex_lock(gc_Mutex* in_mutex)
+static gc_int32 gcX_mutex_try(gc_Mutex* in_mutex)
+{
+  return pthread_mutex_trylock((pthread_mutex_t*)in_mutex->mutex) == 0 ? 1 : 0;
+}
+static void gcX_mutex_wait(gc_Mutex* in_mutex)
 {
   pthread_mutex_lock((pthread_mutex_t*)in_mutex->mutex);
 }
@@ -184,7 +334,371 @@ void gc_mutex_unlock(gc_Mutex* in_mutex)
 {
   pthread_mutex_unlock((pthread_mutex_t*)in_mutex->mutex);
 }
+gc_uint64 gc_time_ns()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (gc_uint64)ts.tv_sec * 1000000000 + (gc_uint64)ts.tv_nsec;
+}
 
 #else
 #error Mutex class not yet defined for this platform
 #endif /* _WIN32 */
+
+/* Lock statistics are aggregated per mutex name ("lock class"), so that the
+   many instances of e.g. ga_Handle::handleMutex show up as a single entry */
+#define GCX_MUTEX_MAX_CLASSES 128
+
+typedef struct gcX_MutexClass {
+  const char* volatile name;
+  volatile gc_int32 numMutexes;
+  volatile gc_int64 numLocks;
+  volatile gc_int64 numContended;
+  volatile gc_int64 waitNs;
+} gcX_MutexClass;
+
+static gcX_MutexClass s_mutexClasses[GCX_MUTEX_MAX_CLASSES];
+
+static gcX_MutexClass* gcX_mutex_class(const char* in_name)
+{
+  gc_int32 i;
+  for(i = 0; i < GCX_MUTEX_MAX_CLASSES; ++i)
+  {
+    gcX_MutexClass* mc = &s_mutexClasses[i];
+    const char* name = (const char*)gc_atomic_load_ptr((void* volatile*)&mc->name);
+    if(!name)
+      name = (const char*)gc_atomic_cas_ptr((void* volatile*)&mc->name, 0, (void*)in_name);
+    if(!name || name == in_name || !strcmp(name, in_name))
+      return mc;
+  }
+  return 0; /* Table full; the mutex is not profiled */
+}
+
+gc_Mutex* gc_mutex_create()
+{
+  return gc_mutex_create_named("unnamed");
+}
+gc_Mutex* gc_mutex_create_named(const char* in_name)
+{
+  gc_Mutex* ret = gcX_ops->allocFunc(sizeof(gc_Mutex));
+  gcX_mutex_init(ret);
+  ret->name = in_name;
+  ret->stats = 0;
+  if(gcX_ops->mutexProfiling)
+  {
+    gcX_MutexClass* mc = gcX_mutex_class(in_name);
+    if(mc)
+      gc_atomic_add(&mc->numMutexes, 1);
+    ret->stats = mc;
+  }
+  return ret;
+}
+void gc_mutex_lock(gc_Mutex* in_mutex)
+{
+  gcX_MutexClass* mc = (gcX_MutexClass*)in_mutex->stats;
+  gc_int32 checkRealtime = gcX_ops->realtimeCheckMode && s_realtimeThread;
+  gc_uint64 start = 0;
+  if(!mc && !checkRealtime)
+  {
+    gcX_mutex_wait(in_mutex);
+    return;
+  }
+  if(gcX_mutex_try(in_mutex))
+  {
+    if(mc)
+      gc_atomic_add64(&mc->numLocks, 1);
+    return;
+  }
+  if(checkRealtime)
+    gcX_realtime_violation(GC_REALTIME_VIOLATION_LOCK, GCX_RETURN_ADDRESS());
+  if(mc)
+    start = gc_time_ns();
+  gcX_mutex_wait(in_mutex);
+  if(mc)
+  {
+    gc_atomic_add64(&mc->numLocks, 1);
+    gc_atomic_add64(&mc->numContended, 1);
+    gc_atomic_add64(&mc->waitNs, (gc_int64)(gc_time_ns() - start));
+  }
+}
+gc_int32 gc_mutex_stats(gc_MutexStats* out_stats, gc_int32 in_max)
+{
+  /* Selection of the top in_max classes by contended count (then wait time) */
+  gc_int32 numOut = 0;
+  gc_int32 i, j;
+  for(i = 0; i < GCX_MUTEX_MAX_CLASSES; ++i)
+  {
+    gcX_MutexClass* mc = &s_mutexClasses[i];
+    gc_MutexStats st;
+    st.name = (const char*)gc_atomic_load_ptr((void* volatile*)&mc->name);
+    if(!st.name)
+      break;
+    st.numMutexes = gc_atomic_add(&mc->numMutexes, 0);
+    st.numLocks = gc_atomic_add64(&mc->numLocks, 0);
+    st.numContended = gc_atomic_add64(&mc->numContended, 0);
+    st.waitNs = gc_atomic_add64(&mc->waitNs, 0);
+    for(j = numOut; j > 0; --j)
+    {
+      gc_MutexStats* prev = &out_stats[j - 1];
+      if(prev->numContended > st.numContended ||
+         (prev->numContended == st.numContended && prev->waitNs >= st.waitNs))
+        break;
+      if(j < in_max)
+        out_stats[j] = *prev;
+    }
+    if(j < in_max)
+    {
+      out_stats[j] = st;
+      if(numOut < in_max)
+        ++numOut;
+    }
+  }
+  return numOut;
+}
+void gc_mutex_stats_reset()
+{
+  gc_int32 i;
+  for(i = 0; i < GCX_MUTEX_MAX_CLASSES; ++i)
+  {
+    gcX_MutexClass* mc = &s_mutexClasses[i];
+    gc_atomic_add64(&mc->numLocks, -gc_atomic_add64(&mc->numLocks, 0));
+    gc_atomic_add64(&mc->numContended, -gc_atomic_add64(&mc->numContended, 0));
+    gc_atomic_add64(&mc->waitNs, -gc_atomic_add64(&mc->waitNs, 0));
+  }
+}
+
+/* Atomic Functions */
+
+#ifdef _WIN32
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+void* gc_atomic_load_ptr(void* volatile* in_ptr)
+{
+  void* ret = *in_ptr;
+  MemoryBarrier();
+  return ret;
+}
+void gc_atomic_store_ptr(void* volatile* in_ptr, void* in_value)
+{
+  MemoryBarrier();
+  *in_ptr = in_value;
+}
+gc_int32 gc_atomic_load(volatile gc_int32* in_ptr)
+{
+  gc_int32 ret = *in_ptr;
+  MemoryBarrier();
+  return ret;
+}
+void gc_atomic_store(volatile gc_int32* in_ptr, gc_int32 in_value)
+{
+  MemoryBarrier();
+  *in_ptr = in_value;
+}
+gc_int64 gc_atomic_load64(volatile gc_int64* in_ptr)
+{
+  /* A 64-bit plain load can tear on 32-bit targets */
+  return InterlockedCompareExchange64((LONGLONG volatile*)in_ptr, 0, 0);
+}
+void gc_atomic_store64(volatile gc_int64* in_ptr, gc_int64 in_value)
+{
+  InterlockedExchange64((LONGLONG volatile*)in_ptr, in_value);
+}
+void* gc_atomic_exchange_ptr(void* volatile* in_ptr, void* in_value)
+{
+  return InterlockedExchangePointer((PVOID volatile*)in_ptr, in_value);
+}
+void* gc_atomic_cas_ptr(void* volatile* in_ptr, void* in_expected, void* in_value)
+{
+  return InterlockedCompareExchangePointer((PVOID volatile*)in_ptr, in_value, in_expected);
+}
+gc_int32 gc_atomic_cas(volatile gc_int32* in_ptr, gc_int32 in_expected, gc_int32 in_value)
+{
+  return InterlockedCompareExchange((LONG volatile*)in_ptr, in_value, in_expected);
+}
+gc_int64 gc_atomic_cas64(volatile gc_int64* in_ptr, gc_int64 in_expected, gc_int64 in_value)
+{
+  return InterlockedCompareExchange64((LONGLONG volatile*)in_ptr, in_value, in_expected);
+}
+gc_int32 gc_atomic_add(volatile gc_int32* in_ptr, gc_int32 in_value)
+{
+  return InterlockedExchangeAdd((LONG volatile*)in_ptr, in_value) + in_value;
+}
+gc_int64 gc_atomic_add64(volatile gc_int64* in_ptr, gc_int64 in_value)
+{
+  return InterlockedExchangeAdd64((LONGLONG volatile*)in_ptr, in_value) + in_value;
+}
+
+#elif defined(__GNUC__)
+
+void* gc_atomic_load_ptr(void* volatile* in_ptr)
+{
+  return __atomic_load_n(in_ptr, __ATOMIC_ACQUIRE);
+}
+void gc_atomic_store_ptr(void* volatile* in_ptr, void* in_value)
+{
+  __atomic_store_n(in_ptr, in_value, __ATOMIC_RELEASE);
+}
+gc_int32 gc_atomic_load(volatile gc_int32* in_ptr)
+{
+  return __atomic_load_n(in_ptr, __ATOMIC_ACQUIRE);
+}
+void gc_atomic_store(volatile gc_int32* in_ptr, gc_int32 in_value)
+{
+  __atomic_store_n(in_ptr, in_value, __ATOMIC_RELEASE);
+}
+gc_int64 gc_atomic_load64(volatile gc_int64* in_ptr)
+{
+  return __atomic_load_n(in_ptr, __ATOMIC_ACQUIRE);
+}
+void gc_atomic_store64(volatile gc_int64* in_ptr, gc_int64 in_value)
+{
+  __atomic_store_n(in_ptr, in_value, __ATOMIC_RELEASE);
+}
+void* gc_atomic_exchange_ptr(void* volatile* in_ptr, void* in_value)
+{
+  return __atomic_exchange_n(in_ptr, in_value, __ATOMIC_SEQ_CST);
+}
+void* gc_atomic_cas_ptr(void* volatile* in_ptr, void* in_expected, void* in_value)
+{
+  __atomic_compare_exchange_n(in_ptr, &in_expected, in_value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+  return in_expected;
+}
+gc_int32 gc_atomic_cas(volatile gc_int32* in_ptr, gc_int32 in_expected, gc_int32 in_value)
+{
+  __atomic_compare_exchange_n(in_ptr, &in_expected, in_value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+  return in_expected;
+}
+gc_int64 gc_atomic_cas64(volatile gc_int64* in_ptr, gc_int64 in_expected, gc_int64 in_value)
+{
+  __atomic_compare_exchange_n(in_ptr, &in_expected, in_value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+  return in_expected;
+}
+gc_int32 gc_atomic_add(volatile gc_int32* in_ptr, gc_int32 in_value)
+{
+  return __atomic_add_fetch(in_ptr, in_value, __ATOMIC_SEQ_CST);
+}
+gc_int64 gc_atomic_add64(volatile gc_int64* in_ptr, gc_int64 in_value)
+{
+  return __atomic_add_fetch(in_ptr, in_value, __ATOMIC_SEQ_CST);
+}
+
+#else
+#error Atomic functions not yet defined for this platform
+#endif /* _WIN32 */
+
+/* Event Functions */
+
+#ifdef _WIN32
+
+static void gcX_event_init(gc_Event* in_event)
+{
+  in_event->event = CreateEvent(0, FALSE, FALSE, 0); /* Auto-reset */
+}
+static void gcX_event_post(gc_Event* in_event)
+{
+  SetEvent((HANDLE)in_event->event);
+}
+static void gcX_event_block(gc_Event* in_event, gc_uint32 in_timeoutMs)
+{
+  WaitForSingleObject((HANDLE)in_event->event, in_timeoutMs);
+}
+static void gcX_event_fini(gc_Event* in_event)
+{
+  CloseHandle((HANDLE)in_event->event);
+}
+
+#elif defined(__linux__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif /* __linux__ */
+
+/* An eventfd where available, else a pipe; both ends are non-blocking */
+typedef struct gcX_EventFds {
+  int readFd;
+  int writeFd;
+} gcX_EventFds;
+
+static void gcX_event_init(gc_Event* in_event)
+{
+  gcX_EventFds* fds = (gcX_EventFds*)gcX_ops->allocFunc(sizeof(gcX_EventFds));
+#ifdef __linux__
+  fds->readFd = fds->writeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#else
+  int p[2];
+  pipe(p);
+  fcntl(p[0], F_SETFL, O_NONBLOCK);
+  fcntl(p[1], F_SETFL, O_NONBLOCK);
+  fds->readFd = p[0];
+  fds->writeFd = p[1];
+#endif /* __linux__ */
+  in_event->event = fds;
+}
+static void gcX_event_post(gc_Event* in_event)
+{
+  gcX_EventFds* fds = (gcX_EventFds*)in_event->event;
+  gc_uint64 one = 1;
+  ssize_t written = write(fds->writeFd, &one, sizeof(one));
+  (void)written; /* A full pipe already wakes the reader */
+}
+static void gcX_event_block(gc_Event* in_event, gc_uint32 in_timeoutMs)
+{
+  gcX_EventFds* fds = (gcX_EventFds*)in_event->event;
+  struct pollfd pfd;
+  char drain[64];
+  pfd.fd = fds->readFd;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+  if(poll(&pfd, 1, (int)in_timeoutMs) > 0)
+    while(read(fds->readFd, drain, sizeof(drain)) > 0) {}
+}
+static void gcX_event_fini(gc_Event* in_event)
+{
+  gcX_EventFds* fds = (gcX_EventFds*)in_event->event;
+  close(fds->readFd);
+  if(fds->writeFd != fds->readFd)
+    close(fds->writeFd);
+  gcX_ops->freeFunc(fds);
+}
+
+#else
+#error Event functions not yet defined for this platform
+#endif /* _WIN32 */
+
+gc_Event* gc_event_create()
+{
+  gc_Event* ret = gcX_ops->allocFunc(sizeof(gc_Event));
+  ret->signaled = 0;
+  gcX_event_init(ret);
+  return ret;
+}
+void gc_event_signal(gc_Event* in_event)
+{
+  /* Coalesce: only the signal that raises the count from 0 posts */
+  if(gc_atomic_add(&in_event->signaled, 1) == 1)
+    gcX_event_post(in_event);
+}
+gc_int32 gc_event_wait(gc_Event* in_event, gc_uint32 in_timeoutMs)
+{
+  /* Signals that arrive between the wakeup and the reset below stay counted,
+     and make the next wait return immediately */
+  gc_int32 count = gc_atomic_load(&in_event->signaled);
+  if(!count)
+  {
+    gcX_event_block(in_event, in_timeoutMs);
+    count = gc_atomic_load(&in_event->signaled);
+  }
+  while(count && gc_atomic_cas(&in_event->signaled, count, 0) != count)
+    count = gc_atomic_load(&in_event->signaled); /* Another waiter took it, or a new signal */
+  return count ? GC_TRUE : GC_FALSE;
+}
+void gc_event_destroy(gc_Event* in_event)
+{
+  gcX_event_fini(in_event);
+  gcX_ops->freeFunc(in_event);
+}
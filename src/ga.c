@@ -192,6 +192,11 @@ gc_result ga_device_queue(ga_Device* in_device,
   return GC_ERROR_GENERIC;
 }
 
+gc_int32 gaX_clamp32(gc_int64 in_value)
+{
+  return in_value > 0x7fffffff ? 0x7fffffff : (gc_int32)in_value;
+}
+
 /* Data Source Structure */
 void ga_data_source_init(ga_DataSource* in_dataSrc)
 {
@@ -199,9 +204,10 @@ void ga_data_source_init(ga_DataSource* in_dataSrc)
   in_dataSrc->readFunc = 0;
   in_dataSrc->seekFunc = 0; 
   in_dataSrc->tellFunc = 0;
+  in_dataSrc->borrowFunc = 0;
   in_dataSrc->closeFunc = 0;
   in_dataSrc->flags = 0;
-  in_dataSrc->refMutex = gc_mutex_create();
+  in_dataSrc->refMutex = gc_mutex_create_named("ga_DataSource::refMutex");
 }
 gc_int32 ga_data_source_read(ga_DataSource* in_dataSrc, void* in_dst, gc_int32 in_size, gc_int32 in_count)
 {
@@ -211,6 +217,10 @@ gc_int32 ga_data_source_read(ga_DataSource* in_dataSrc, void* in_dst, gc_int32 i
   return func(context, in_dst, in_size, in_count);
 }
 gc_int32 ga_data_source_seek(ga_DataSource* in_dataSrc, gc_int32 in_offset, gc_int32 in_origin)
+{
+  return ga_data_source_seek64(in_dataSrc, in_offset, in_origin);
+}
+gc_int32 ga_data_source_seek64(ga_DataSource* in_dataSrc, gc_int64 in_offset, gc_int32 in_origin)
 {
   tDataSourceFunc_Seek func = in_dataSrc->seekFunc;
   char* context = (char*)in_dataSrc + sizeof(ga_DataSource);
@@ -219,6 +229,10 @@ gc_int32 ga_data_source_seek(ga_DataSource* in_dataSrc, gc_int32 in_offset, gc_i
   return -1;
 }
 gc_int32 ga_data_source_tell(ga_DataSource* in_dataSrc)
+{
+  return gaX_clamp32(ga_data_source_tell64(in_dataSrc));
+}
+gc_int64 ga_data_source_tell64(ga_DataSource* in_dataSrc)
 {
   tDataSourceFunc_Tell func = in_dataSrc->tellFunc;
   char* context = (char*)in_dataSrc + sizeof(ga_DataSource);
@@ -226,6 +240,14 @@ gc_int32 ga_data_source_tell(ga_DataSource* in_dataSrc)
     return func(context);
   return -1;
 }
+gc_int32 ga_data_source_borrow(ga_DataSource* in_dataSrc, gc_int32 in_maxBytes, const void** out_data)
+{
+  tDataSourceFunc_Borrow func = in_dataSrc->borrowFunc;
+  char* context = (char*)in_dataSrc + sizeof(ga_DataSource);
+  if(func)
+    return func(context, in_maxBytes, out_data);
+  return -1;
+}
 gc_int32 ga_data_source_flags(ga_DataSource* in_dataSrc)
 {
   return in_dataSrc->flags;
@@ -268,8 +290,10 @@ void ga_sample_source_init(ga_SampleSource* in_sampleSrc)
   in_sampleSrc->seekFunc = 0; 
   in_sampleSrc->tellFunc = 0;
   in_sampleSrc->closeFunc = 0;
+  in_sampleSrc->peekFunc = 0;
+  in_sampleSrc->commitFunc = 0;
   in_sampleSrc->flags = 0;
-  in_sampleSrc->refMutex = gc_mutex_create();
+  in_sampleSrc->refMutex = gc_mutex_create_named("ga_SampleSource::refMutex");
 }
 gc_int32 ga_sample_source_read(ga_SampleSource* in_sampleSrc, void* in_dst, gc_int32 in_numSamples,
                                tOnSeekFunc in_onSeekFunc, void* in_seekContext)
@@ -278,6 +302,21 @@ gc_int32 ga_sample_source_read(ga_SampleSource* in_sampleSrc, void* in_dst, gc_i
   assert(func);
   return func(in_sampleSrc, in_dst, in_numSamples, in_onSeekFunc, in_seekContext);
 }
+gc_int32 ga_sample_source_peek(ga_SampleSource* in_sampleSrc, gc_int32 in_numSamples,
+                               void** out_dataA, gc_int32* out_samplesA,
+                               void** out_dataB, gc_int32* out_samplesB)
+{
+  tSampleSourceFunc_Peek func = in_sampleSrc->peekFunc;
+  if(func)
+    return func(in_sampleSrc, in_numSamples, out_dataA, out_samplesA, out_dataB, out_samplesB);
+  return -1;
+}
+void ga_sample_source_commit(ga_SampleSource* in_sampleSrc, gc_int32 in_numSamples)
+{
+  tSampleSourceFunc_Commit func = in_sampleSrc->commitFunc;
+  assert(func);
+  func(in_sampleSrc, in_numSamples);
+}
 gc_int32 ga_sample_source_end(ga_SampleSource* in_sampleSrc)
 {
   tSampleSourceFunc_End func = in_sampleSrc->endFunc;
@@ -285,6 +324,10 @@ gc_int32 ga_sample_source_end(ga_SampleSource* in_sampleSrc)
   return func(in_sampleSrc);
 }
 gc_int32 ga_sample_source_seek(ga_SampleSource* in_sampleSrc, gc_int32 in_sampleOffset)
+{
+  return ga_sample_source_seek64(in_sampleSrc, in_sampleOffset);
+}
+gc_int32 ga_sample_source_seek64(ga_SampleSource* in_sampleSrc, gc_int64 in_sampleOffset)
 {
   tSampleSourceFunc_Seek func = in_sampleSrc->seekFunc;
   if(func)
@@ -292,12 +335,20 @@ gc_int32 ga_sample_source_seek(ga_SampleSource* in_sampleSrc, gc_int32 in_sample
   return -1;
 }
 gc_int32 ga_sample_source_tell(ga_SampleSource* in_sampleSrc, gc_int32* out_totalSamples)
+{
+  gc_int64 total;
+  gc_int64 ret = ga_sample_source_tell64(in_sampleSrc, &total);
+  if(out_totalSamples)
+    *out_totalSamples = gaX_clamp32(total);
+  return gaX_clamp32(ret);
+}
+gc_int64 ga_sample_source_tell64(ga_SampleSource* in_sampleSrc, gc_int64* out_totalSamples)
 {
   tSampleSourceFunc_Tell func = in_sampleSrc->tellFunc;
-  char* context = (char*)in_sampleSrc + sizeof(ga_SampleSource);
   if(func)
     return func(in_sampleSrc, out_totalSamples);
-  *out_totalSamples = -1;
+  if(out_totalSamples)
+    *out_totalSamples = -1;
   return -1;
 }
 gc_int32 ga_sample_source_flags(ga_SampleSource* in_sampleSrc)
@@ -342,18 +393,20 @@ gc_int32 ga_sample_source_ready(ga_SampleSource* in_sampleSrc, gc_int32 in_numSa
 }
 
 /* Memory Functions */
-static ga_Memory* gaX_memory_create(void* in_data, gc_int32 in_size, gc_int32 in_copy)
+static ga_Memory* gaX_memory_create(void* in_data, gc_int64 in_size, gc_int32 in_copy)
 {
   ga_Memory* ret = gcX_ops->allocFunc(sizeof(ga_Memory));
   ret->size = in_size;
   if(in_copy)
   {
-    ret->data = gcX_ops->allocFunc(in_size);
-    memcpy(ret->data, in_data, in_size);
+    ret->data = gcX_ops->allocFunc((gc_uint32)in_size);
+    memcpy(ret->data, in_data, (size_t)in_size);
   }
   else
     ret->data = in_data;
-  ret->refMutex = gc_mutex_create();
+  ret->mapping = 0;
+  ret->parent = 0;
+  ret->refMutex = gc_mutex_create_named("ga_Memory::refMutex");
   ret->refCount = 1;
   return (ga_Memory*)ret;
 }
@@ -381,7 +434,32 @@ ga_Memory* ga_memory_create_data_source(ga_DataSource* in_dataSource)
     gcX_ops->freeFunc(data);
   return ret;
 }
+ga_Memory* ga_memory_create_mapped(const char* in_filename)
+{
+  ga_Memory* ret;
+  gc_MappedFile* mapping = gc_file_map(in_filename);
+  if(!mapping)
+    return 0;
+  ret = gaX_memory_create(mapping->data, mapping->size, 0);
+  ret->mapping = mapping;
+  return ret;
+}
+ga_Memory* ga_memory_create_view(ga_Memory* in_mem, gc_int32 in_offset, gc_int32 in_size)
+{
+  ga_Memory* ret;
+  if(in_offset < 0 || in_size < 0 || in_offset > in_mem->size ||
+     in_size > in_mem->size - in_offset)
+    return 0;
+  ret = gaX_memory_create((char*)in_mem->data + in_offset, in_size, 0);
+  ga_memory_acquire(in_mem);
+  ret->parent = in_mem;
+  return ret;
+}
 gc_int32 ga_memory_size(ga_Memory* in_mem)
+{
+  return gaX_clamp32(in_mem->size);
+}
+gc_int64 ga_memory_size64(ga_Memory* in_mem)
 {
   return in_mem->size;
 }
@@ -391,7 +469,13 @@ void* ga_memory_data(ga_Memory* in_mem)
 }
 static void gaX_memory_destroy(ga_Memory* in_mem)
 {
-  gcX_ops->freeFunc(in_mem->data);
+  if(in_mem->parent)
+    ga_memory_release(in_mem->parent);
+  else if(in_mem->mapping)
+    gc_file_unmap(in_mem->mapping);
+  else
+    gcX_ops->freeFunc(in_mem->data);
+  gc_mutex_destroy(in_mem->refMutex);
   gcX_ops->freeFunc(in_mem);
 }
 void ga_memory_acquire(ga_Memory* in_mem)
@@ -417,11 +501,11 @@ void ga_memory_release(ga_Memory* in_mem)
 ga_Sound* ga_sound_create(ga_Memory* in_memory, ga_Format* in_format)
 {
   ga_Sound* ret = gcX_ops->allocFunc(sizeof(ga_Sound));
-  ret->numSamples = ga_memory_size(in_memory) / ga_format_sampleSize(in_format);
+  ret->numSamples = gaX_clamp32(ga_memory_size64(in_memory) / ga_format_sampleSize(in_format));
   memcpy(&ret->format, in_format, sizeof(ga_Format));
   ga_memory_acquire(in_memory);
   ret->memory = in_memory;
-  ret->refMutex = gc_mutex_create();
+  ret->refMutex = gc_mutex_create_named("ga_Sound::refMutex");
   ret->refCount = 1;
   return (ga_Sound*)ret;
 }
@@ -448,8 +532,7 @@ ga_Sound* ga_sound_create_sample_source(ga_SampleSource* in_sampleSrc)
     if(memory)
     {
       ret = ga_sound_create(memory, &format);
-      if(!ret)
-        ga_memory_release(memory);
+      ga_memory_release(memory); /* The sound holds its own reference */
     }
     else
       gcX_ops->freeFunc(data);
@@ -476,8 +559,7 @@ ga_Sound* ga_sound_create_sample_source(ga_SampleSource* in_sampleSrc)
     if(memory)
     {
       ret = ga_sound_create(memory, &format);
-      if(!ret)
-        ga_memory_release(memory);
+      ga_memory_release(memory); /* The sound holds its own reference */
     }
     else
       gcX_ops->freeFunc(data);
@@ -494,7 +576,7 @@ gc_int32 ga_sound_size(ga_Sound* in_sound)
 }
 gc_int32 ga_sound_numSamples(ga_Sound* in_sound)
 {
-  return ga_memory_size(in_sound->memory) / ga_format_sampleSize(&in_sound->format);
+  return gaX_clamp32(ga_memory_size64(in_sound->memory) / ga_format_sampleSize(&in_sound->format));
 }
 void ga_sound_format(ga_Sound* in_sound, ga_Format* out_format)
 {
@@ -503,6 +585,7 @@ void ga_sound_format(ga_Sound* in_sound, ga_Format* out_format)
 static void gaX_sound_destroy(ga_Sound* in_sound)
 {
   ga_memory_release(in_sound->memory);
+  gc_mutex_destroy(in_sound->refMutex);
   gcX_ops->freeFunc(in_sound);
 }
 void ga_sound_acquire(ga_Sound* in_sound)
@@ -524,6 +607,41 @@ void ga_sound_release(ga_Sound* in_sound)
 }
 
 /* Handle Functions */
+static void gaX_mixer_reserve_src(ga_Mixer* in_mixer, ga_SampleSource* in_sampleSrc, gc_float32 in_pitch)
+{
+  /* Grows the mixer's scratch buffer off the mix thread, before the handle needs it */
+  ga_Mixer* m = in_mixer;
+  ga_Format format;
+  gc_float32 dstToSrc;
+  gc_int32 bytes;
+  gc_int32 grow;
+  void* buffer;
+  void* retired = 0;
+  ga_sample_source_format(in_sampleSrc, &format);
+  dstToSrc = format.sampleRate / (gc_float32)m->format.sampleRate * in_pitch;
+  bytes = ((gc_int32)(m->numSamples * dstToSrc) + 1) * ga_format_sampleSize(&format);
+  gc_mutex_lock(m->mixMutex);
+  grow = bytes > m->srcBufferReserved;
+  gc_mutex_unlock(m->mixMutex);
+  if(!grow)
+    return;
+  buffer = gc_realtime_alloc(bytes);
+  gc_mutex_lock(m->mixMutex);
+  if(bytes > m->srcBufferReserved)
+  {
+    void* pending = m->srcBufferPending;
+    m->srcBufferPending = buffer;
+    m->srcBufferReserved = bytes;
+    buffer = pending; /* Never adopted; superseded */
+    retired = m->srcBufferRetired;
+    m->srcBufferRetired = 0;
+  }
+  gc_mutex_unlock(m->mixMutex);
+  if(buffer)
+    gc_realtime_free(buffer);
+  if(retired)
+    gc_realtime_free(retired);
+}
 void gaX_handle_init(ga_Handle* in_handle, ga_Mixer* in_mixer)
 {
   ga_Handle* h = in_handle;
@@ -534,7 +652,7 @@ void gaX_handle_init(ga_Handle* in_handle, ga_Mixer* in_mixer)
   h->gain = 1.0f;
   h->pitch = 1.0f;
   h->pan = 0.0f;
-  h->handleMutex = gc_mutex_create();
+  h->handleMutex = gc_mutex_create_named("ga_Handle::handleMutex");
 }
 
 ga_Handle* ga_handle_create(ga_Mixer* in_mixer,
@@ -544,24 +662,32 @@ ga_Handle* ga_handle_create(ga_Mixer* in_mixer,
   ga_sample_source_acquire(in_sampleSrc);
   h->sampleSrc = in_sampleSrc;
   h->finished = 0;
+  h->retired = 0;
+  h->queued = 0;
+  h->dispatchLink.next = 0;
   gaX_handle_init(h, in_mixer);
+  gaX_mixer_reserve_src(in_mixer, in_sampleSrc, h->pitch);
 
   gc_mutex_lock(in_mixer->mixMutex);
   gc_list_link(&in_mixer->mixList, &h->mixLink, h);
   gc_mutex_unlock(in_mixer->mixMutex);
 
-  gc_mutex_lock(in_mixer->dispatchMutex);
-  gc_list_link(&in_mixer->dispatchList, &h->dispatchLink, h);
-  gc_mutex_unlock(in_mixer->dispatchMutex);
-
   return h;
 }
 gc_result ga_handle_destroy(ga_Handle* in_handle)
 {
   /* Sets the destroyed state. Will be cleaned up once all threads ACK. */
-  gc_mutex_lock(in_handle->handleMutex);
-  in_handle->state = GA_HANDLE_STATE_DESTROYED;
-  gc_mutex_unlock(in_handle->handleMutex);
+  ga_Handle* h = in_handle;
+  gc_int32 doQueue;
+  gc_mutex_lock(h->handleMutex);
+  h->state = GA_HANDLE_STATE_DESTROYED;
+  /* If the mixer already retired the handle, it will never queue it again */
+  doQueue = h->retired && !h->queued;
+  if(doQueue)
+    h->queued = 1;
+  gc_mutex_unlock(h->handleMutex);
+  if(doQueue)
+    gc_queue_push(&h->mixer->dispatchQueue, &h->dispatchNode, h);
   return GC_SUCCESS;
 }
 gc_result gaX_handle_cleanup(ga_Handle* in_handle)
@@ -638,6 +764,7 @@ gc_result ga_handle_setParamf(ga_Handle* in_handle, gc_int32 in_param,
     gc_mutex_unlock(h->handleMutex);
     return GC_SUCCESS;
   case GA_HANDLE_PARAM_PITCH:
+    gaX_mixer_reserve_src(h->mixer, h->sampleSrc, in_value);
     gc_mutex_lock(h->handleMutex);
     h->pitch = in_value;
     gc_mutex_unlock(h->handleMutex);
@@ -686,13 +813,21 @@ gc_result ga_handle_getParami(ga_Handle* in_handle, gc_int32 in_param,
 }
 gc_result ga_handle_seek(ga_Handle* in_handle, gc_int32 in_sampleOffset)
 {
-  ga_sample_source_seek(in_handle->sampleSrc, in_sampleOffset);
+  return ga_handle_seek64(in_handle, in_sampleOffset);
+}
+gc_result ga_handle_seek64(ga_Handle* in_handle, gc_int64 in_sampleOffset)
+{
+  ga_sample_source_seek64(in_handle->sampleSrc, in_sampleOffset);
   return GC_SUCCESS;
 }
 gc_int32 ga_handle_tell(ga_Handle* in_handle, gc_int32 in_param)
 {
-  gc_int32 total = 0;
-  gc_int32 cur = ga_sample_source_tell(in_handle->sampleSrc, &total);
+  return gaX_clamp32(ga_handle_tell64(in_handle, in_param));
+}
+gc_int64 ga_handle_tell64(ga_Handle* in_handle, gc_int32 in_param)
+{
+  gc_int64 total = 0;
+  gc_int64 cur = ga_sample_source_tell64(in_handle->sampleSrc, &total);
   if(in_param == GA_TELL_PARAM_CURRENT)
     return cur;
   else if(in_param == GA_TELL_PARAM_TOTAL)
@@ -713,6 +848,7 @@ ga_Mixer* ga_mixer_create(ga_Format* in_format, gc_int32 in_numSamples)
 {
   ga_Mixer* ret = gcX_ops->allocFunc(sizeof(ga_Mixer));
   gc_int32 mixSampleSize;
+  gc_queue_init(&ret->dispatchQueue);
   gc_list_head(&ret->dispatchList);
   gc_list_head(&ret->mixList);
   ret->numSamples = in_numSamples;
@@ -721,9 +857,15 @@ ga_Mixer* ga_mixer_create(ga_Format* in_format, gc_int32 in_numSamples)
   ret->mixFormat.numChannels = in_format->numChannels;
   ret->mixFormat.sampleRate = in_format->sampleRate;
   mixSampleSize = ga_format_sampleSize(&ret->mixFormat);
-  ret->mixBuffer = (gc_int32*)gcX_ops->allocFunc(in_numSamples * mixSampleSize);
-  ret->dispatchMutex = gc_mutex_create();
-  ret->mixMutex = gc_mutex_create();
+  ret->mixBuffer = (gc_int32*)gc_realtime_alloc(in_numSamples * mixSampleSize);
+  /* Enough for sources in the mixer's format at up to 2x pitch; handles
+     that need more reserve it when they are created or repitched */
+  ret->srcBufferSize = (in_numSamples * 2 + 1) * ga_format_sampleSize(&ret->format);
+  ret->srcBuffer = gc_realtime_alloc(ret->srcBufferSize);
+  ret->srcBufferPending = 0;
+  ret->srcBufferRetired = 0;
+  ret->srcBufferReserved = ret->srcBufferSize;
+  ret->mixMutex = gc_mutex_create_named("ga_Mixer::mixMutex");
   return ret;
 }
 ga_Format* ga_mixer_format(ga_Mixer* in_mixer)
@@ -804,7 +946,6 @@ void gaX_mixer_mix_handle(ga_Mixer* in_mixer, ga_Handle* in_handle, gc_int32 in_
       {
         /* Check if we have enough samples to stream a full buffer */
         gc_int32 srcSampleSize = ga_format_sampleSize(&handleFormat);
-        gc_int32 dstSampleSize = ga_format_sampleSize(&m->format);
         gc_float32 oldPitch = h->pitch;
         gc_float32 dstToSrc = handleFormat.sampleRate / (gc_float32)m->format.sampleRate * oldPitch;
         gc_int32 requested = (gc_int32)(in_numSamples * dstToSrc);
@@ -835,17 +976,53 @@ void gaX_mixer_mix_handle(ga_Mixer* in_mixer, ga_Handle* in_handle, gc_int32 in_
           dstBuffer = &m->mixBuffer[0];
           dstSamples = in_numSamples;
           {
-            /* TODO: To optimize, we can refactor the _read() interface to be _mix(), avoiding this malloc/copy */
-            gc_int32 bufferSize = requested * srcSampleSize;
-            void* src = gcX_ops->allocFunc(bufferSize);
-            gc_int32 dstBytes = dstSamples * dstSampleSize;
-            gc_int32 numRead = 0;
-            numRead = ga_sample_source_read(ss, src, requested, 0, 0);
-            gaX_mixer_mix_buffer(in_mixer,
-                                 src, numRead, &handleFormat,
-                                 dstBuffer, dstSamples, &m->format,
-                                 gain, pan, pitch);
-            gcX_ops->freeFunc(src);
+            void* srcA;
+            void* srcB;
+            gc_int32 numA, numB;
+            gc_int32 numRead = ga_sample_source_peek(ss, requested, &srcA, &numA, &srcB, &numB);
+            if(numRead >= 0 && numB == 0)
+            {
+              /* Mix straight out of the source's buffer */
+              gaX_mixer_mix_buffer(in_mixer,
+                                   srcA, numRead, &handleFormat,
+                                   dstBuffer, dstSamples, &m->format,
+                                   gain, pan, pitch);
+              ga_sample_source_commit(ss, numRead);
+            }
+            else
+            {
+              gc_int32 bufferSize = requested * srcSampleSize;
+              if(bufferSize > m->srcBufferSize)
+              {
+                /* Adopt the larger buffer reserved for this handle; the old
+                   one is freed off the mix thread */
+                gc_mutex_lock(m->mixMutex);
+                if(m->srcBufferPending)
+                {
+                  assert(!m->srcBufferRetired);
+                  m->srcBufferRetired = m->srcBuffer;
+                  m->srcBuffer = m->srcBufferPending;
+                  m->srcBufferSize = m->srcBufferReserved;
+                  m->srcBufferPending = 0;
+                }
+                gc_mutex_unlock(m->mixMutex);
+                if(bufferSize > m->srcBufferSize)
+                  return; /* Not reserved; never allocate on the mix thread */
+              }
+              if(numRead >= 0)
+              {
+                /* Peeked data wraps around the end of the source's buffer */
+                memcpy(m->srcBuffer, srcA, numA * srcSampleSize);
+                memcpy((char*)m->srcBuffer + numA * srcSampleSize, srcB, numB * srcSampleSize);
+                ga_sample_source_commit(ss, numRead);
+              }
+              else
+                numRead = ga_sample_source_read(ss, m->srcBuffer, requested, 0, 0);
+              gaX_mixer_mix_buffer(in_mixer,
+                                   m->srcBuffer, numRead, &handleFormat,
+                                   dstBuffer, dstSamples, &m->format,
+                                   gain, pan, pitch);
+            }
           }
         }
       }
@@ -871,9 +1048,19 @@ gc_result ga_mixer_mix(ga_Mixer* in_mixer, void* out_buffer)
     gaX_mixer_mix_handle(m, (ga_Handle*)h, m->numSamples);
     if(ga_handle_finished(h))
     {
+      gc_int32 doQueue;
       gc_mutex_lock(m->mixMutex);
       gc_list_unlink(oldLink);
       gc_mutex_unlock(m->mixMutex);
+
+      /* Hand the handle over to the dispatch thread */
+      gc_mutex_lock(h->handleMutex);
+      h->retired = 1;
+      doQueue = !h->queued;
+      h->queued = 1;
+      gc_mutex_unlock(h->handleMutex);
+      if(doQueue)
+        gc_queue_push(&m->dispatchQueue, &h->dispatchNode, h);
     }
   }
 
@@ -904,34 +1091,37 @@ gc_result ga_mixer_mix(ga_Mixer* in_mixer, void* out_buffer)
 }
 gc_result ga_mixer_dispatch(ga_Mixer* in_mixer)
 {
+  /* Only visits handles the mixer has retired (finished or destroyed) since
+     the last dispatch, plus retired handles that were destroyed since then */
   ga_Mixer* m = in_mixer;
-  gc_Link* link = m->dispatchList.next;
-  while(link != &m->dispatchList)
+  gc_QueueNode* node;
+  while((node = gc_queue_pop(&m->dispatchQueue)) != 0)
   {
-    gc_Link* oldLink = link;
-    ga_Handle* oldHandle = (ga_Handle*)oldLink->data;
-    link = link->next;
+    ga_Handle* h = (ga_Handle*)node->data;
+    gc_int32 state;
+    gc_mutex_lock(h->handleMutex);
+    h->queued = 0;
+    state = h->state;
+    gc_mutex_unlock(h->handleMutex);
 
-    /* Remove finished handles and call callbacks */
-    if(ga_handle_destroyed(oldHandle))
+    /* Remove destroyed handles and call callbacks */
+    if(state == GA_HANDLE_STATE_DESTROYED)
     {
-      if(!oldHandle->mixLink.next)
-      {
-        /* NOTES ABOUT THREADING POLICY WITH REGARD TO LINKED LISTS: */
-        /* Only a single thread may iterate through any list */
-        /* The thread that unlinks must be the only thread that iterates through the list */
-        /* A single auxiliary thread may link(), but must mutex-lock to avoid link/unlink collisions */
-        gc_mutex_lock(m->dispatchMutex);
-        gc_list_unlink(&oldHandle->dispatchLink);
-        gc_mutex_unlock(m->dispatchMutex);
-        gaX_handle_cleanup(oldHandle);
-      }
+      if(h->dispatchLink.next)
+        gc_list_unlink(&h->dispatchLink);
+      gaX_handle_cleanup(h);
     }
-    else if(oldHandle->callback && ga_handle_finished(oldHandle))
+    else
     {
-      oldHandle->callback(oldHandle, oldHandle->context);
-      oldHandle->callback = 0;
-      oldHandle->context = 0;
+      /* Keep track of the handle until it is destroyed */
+      if(!h->dispatchLink.next)
+        gc_list_link(&m->dispatchList, &h->dispatchLink, h);
+      if(h->callback)
+      {
+        ga_FinishCallback callback = h->callback;
+        h->callback = 0;
+        callback(h, h->context);
+      }
     }
   }
   return GC_SUCCESS;
@@ -941,6 +1131,20 @@ gc_result ga_mixer_destroy(ga_Mixer* in_mixer)
   /* NOTE: Mixer/handles must no longer be in use on any thread when destroy is called */
   ga_Mixer* m = in_mixer;
   gc_Link* link;
+  gc_QueueNode* node;
+  link = m->mixList.next;
+  while(link != &m->mixList)
+  {
+    ga_Handle* oldHandle = (ga_Handle*)link->data;
+    link = link->next;
+    gaX_handle_cleanup(oldHandle);
+  }
+  while((node = gc_queue_pop(&m->dispatchQueue)) != 0)
+  {
+    ga_Handle* oldHandle = (ga_Handle*)node->data;
+    if(!oldHandle->dispatchLink.next)
+      gaX_handle_cleanup(oldHandle);
+  }
   link = m->dispatchList.next;
   while(link != &m->dispatchList)
   {
@@ -949,10 +1153,14 @@ gc_result ga_mixer_destroy(ga_Mixer* in_mixer)
     gaX_handle_cleanup(oldHandle);
   }
 
-  gc_mutex_destroy(in_mixer->dispatchMutex);
   gc_mutex_destroy(in_mixer->mixMutex);
 
-  gcX_ops->freeFunc(in_mixer->mixBuffer);
+  gc_realtime_free(in_mixer->mixBuffer);
+  gc_realtime_free(in_mixer->srcBuffer);
+  if(in_mixer->srcBufferPending)
+    gc_realtime_free(in_mixer->srcBufferPending);
+  if(in_mixer->srcBufferRetired)
+    gc_realtime_free(in_mixer->srcBufferRetired);
   gcX_ops->freeFunc(in_mixer);
   return GC_SUCCESS;
 }
@@ -7,72 +7,12 @@
 
 #include <assert.h>
 
-/* Tell Jumps */
-typedef struct gau_TellJumpData {
-  gc_int32 pos;
-  gc_int32 delta;
-} gau_TellJumpData;
-
-typedef struct gau_TellJumpLink {
-  gc_Link link;
-  gau_TellJumpData data;
-} gau_TellJumpLink;
-
-void gauX_tell_jump_push(gc_Link* in_head, gc_int32 in_pos, gc_int32 in_delta)
-{
-  gau_TellJumpLink* link = gcX_ops->allocFunc(sizeof(gau_TellJumpLink));
-  link->link.data = &link->data;
-  link->data.pos = in_pos;
-  link->data.delta = in_delta;
-  gc_list_link(in_head->prev, (gc_Link*)link, &link->data);
-}
-gc_int32 gauX_tell_jump_peek(gc_Link* in_head, gc_int32* out_pos, gc_int32* out_delta)
-{
-  gau_TellJumpLink* link;
-  if(in_head->next == in_head)
-    return 0;
-  link = (gau_TellJumpLink*)in_head->next;
-  *out_pos = link->data.pos;
-  *out_delta = link->data.delta;
-  return 1;
-}
-gc_int32 gauX_tell_jump_pop(gc_Link* in_head)
-{
-  gau_TellJumpLink* link;
-  if(in_head->next == in_head)
-    return 0;
-  link = (gau_TellJumpLink*)in_head->next;
-  gc_list_unlink((gc_Link*)link);
-  gcX_ops->freeFunc(link);
-  return 1;
-}
-gc_int32 gauX_tell_jump_process(gc_Link* in_head, gc_int32 in_advance)
-{
-  gc_int32 ret = 0;
-  gau_TellJumpLink* link = (gau_TellJumpLink*)in_head->next;
-  while((gc_Link*)link != in_head)
-  {
-    gau_TellJumpLink* oldLink = link;
-    link = (gau_TellJumpLink*)link->link.next;
-    oldLink->data.pos -= in_advance;
-    if(oldLink->data.pos <= 0)
-    {
-      ret += oldLink->data.delta;
-      gc_list_unlink((gc_Link*)oldLink);
-    }
-  }
-  return ret;
-}
-void gauX_tell_jump_clear(gc_Link* in_head)
-{
-  while(gauX_tell_jump_pop(in_head));
-}
-
-
 /* Stream Link */
 typedef struct gaX_StreamLink {
   gc_Link link;
   gc_int32 refCount;
+  gc_int32 claimed; /* Being produced by a worker (guarded by the list mutex) */
+  gc_int32 idlePass; /* Last buffering pass that found nothing to do (guarded by the list mutex) */
   gc_Mutex* produceMutex;
   gc_Mutex* refMutex;
   ga_BufferedStream* stream;
@@ -82,21 +22,40 @@ gaX_StreamLink* gaX_stream_link_create()
 {
   gaX_StreamLink* ret = (gaX_StreamLink*)gcX_ops->allocFunc(sizeof(gaX_StreamLink));
   ret->refCount = 1;
-  ret->refMutex = gc_mutex_create();
-  ret->produceMutex = gc_mutex_create();
+  ret->claimed = 0;
+  ret->idlePass = 0;
+  ret->refMutex = gc_mutex_create_named("gaX_StreamLink::refMutex");
+  ret->produceMutex = gc_mutex_create_named("gaX_StreamLink::produceMutex");
   ret->stream = 0;
   return ret;
 }
-gc_int32 gaX_stream_link_produce(gaX_StreamLink* in_streamLink)
+static gc_int32 gaX_stream_produce(ga_BufferedStream* in_stream, gc_int32 in_maxBytes);
+static gc_float32 gaX_stream_deadline(ga_BufferedStream* in_stream, gc_int32 in_chunkBytes);
+
+gc_int32 gaX_stream_link_produce(gaX_StreamLink* in_streamLink, gc_int32 in_chunkSamples)
 {
-  gc_int32 ret = 1;
+  /* Returns -1 if the stream is dead, else whether any progress was made */
+  gc_int32 ret = -1;
   gc_mutex_lock(in_streamLink->produceMutex);
   if(in_streamLink->stream)
   {
     /* Mutexing this entire section guarantees that ga_stream_destroy()
        cannot occur during production */
-    ga_stream_produce(in_streamLink->stream);
-    ret = 0;
+    ga_BufferedStream* s = in_streamLink->stream;
+    ret = gaX_stream_produce(s, in_chunkSamples * ga_format_sampleSize(&s->format));
+  }
+  gc_mutex_unlock(in_streamLink->produceMutex);
+  return ret;
+}
+gc_float32 gaX_stream_link_deadline(gaX_StreamLink* in_streamLink, gc_int32 in_chunkSamples)
+{
+  /* Dead streams are due immediately, so that they get cleaned up */
+  gc_float32 ret = 0.0f;
+  gc_mutex_lock(in_streamLink->produceMutex);
+  if(in_streamLink->stream)
+  {
+    ga_BufferedStream* s = in_streamLink->stream;
+    ret = gaX_stream_deadline(s, in_chunkSamples * ga_format_sampleSize(&s->format));
   }
   gc_mutex_unlock(in_streamLink->produceMutex);
   return ret;
@@ -132,10 +91,18 @@ void gaX_stream_link_release(gaX_StreamLink* in_streamLink)
 }
 
 /* Stream Manager */
+#define GAX_STREAM_MANAGER_DEFAULT_LOW_WATERMARK 0.75f
+/* Refill granularity: small enough that a starving stream never waits long
+   behind another, large enough to keep decoder call overhead down */
+#define GAX_STREAM_MANAGER_CHUNK_SAMPLES 2048
+
 ga_StreamManager* ga_stream_manager_create()
 {
   ga_StreamManager* ret = (ga_StreamManager*)gcX_ops->allocFunc(sizeof(ga_StreamManager));
-  ret->streamListMutex = gc_mutex_create();
+  ret->streamListMutex = gc_mutex_create_named("ga_StreamManager::streamListMutex");
+  ret->wakeEvent = gc_event_create();
+  ret->lowWatermark = GAX_STREAM_MANAGER_DEFAULT_LOW_WATERMARK;
+  ret->pass = 0;
   gc_list_head(&ret->streamList);
   return ret;
 }
@@ -143,33 +110,94 @@ gaX_StreamLink* gaX_stream_manager_add(ga_StreamManager* in_mgr, ga_BufferedStre
 {
   gaX_StreamLink* streamLink = gaX_stream_link_create(in_stream);
   gaX_stream_link_acquire(streamLink); /* The new client adds its own refcount */
-  /* It's safe to add() while iterating in stream() because of implicit fault tolerance */
-  /* That is, all possible outcomes are valid, despite the race condition */
-  /* This is true because we are guaranteed to stream() on the same thread that calls remove() */
   gc_mutex_lock(in_mgr->streamListMutex);
   streamLink->stream = in_stream;
   gc_list_link(&in_mgr->streamList, (gc_Link*)streamLink, streamLink);
   gc_mutex_unlock(in_mgr->streamListMutex);
   return streamLink;
 }
-void ga_stream_manager_buffer(ga_StreamManager* in_mgr)
+static void gaX_stream_manager_buffer(ga_StreamManager* in_mgr, gc_uint64 in_endNs)
 {
-  gc_Link* link = in_mgr->streamList.next;
-  while(link != &in_mgr->streamList)
+  /* Refills streams in bounded chunks, earliest deadline (time until the
+     consumer runs dry) first, until no stream needs data.
+
+     Any number of workers may run this concurrently. Each claims the most
+     urgent unclaimed stream, so a stream is produced by one worker at a
+     time, and idle workers pick up the remaining ones. Links are only
+     unlinked by their claimer, and the list is only walked under the mutex,
+     so every link visited is still in the list.
+
+     With a non-zero in_endNs, stops after the chunk that reaches that time;
+     the next call resumes with whichever streams are most urgent by then. */
+  gc_int32 pass = gc_atomic_add(&in_mgr->pass, 1);
+  gc_mutex_lock(in_mgr->streamListMutex);
+  for(;;)
   {
-    gc_int32 streamDead;
-    gaX_StreamLink* streamLink;
-    streamLink = (gaX_StreamLink*)link->data;
-    link = link->next;
-    streamDead = gaX_stream_link_produce(streamLink);
-    if(streamDead)
+    gc_int32 progress;
+    gc_int32 numDue = 0;
+    gaX_StreamLink* streamLink = 0;
+    gc_float32 deadline = 0.0f;
+    gc_Link* link = in_mgr->streamList.next;
+    for(; link != &in_mgr->streamList; link = link->next)
+    {
+      gaX_StreamLink* l = (gaX_StreamLink*)link->data;
+      gc_float32 d;
+      if(l->claimed || l->idlePass == pass)
+        continue;
+      d = gaX_stream_link_deadline(l, GAX_STREAM_MANAGER_CHUNK_SAMPLES);
+      if(d < 0.0f)
+      {
+        l->idlePass = pass;
+        continue;
+      }
+      ++numDue;
+      if(!streamLink || d < deadline)
+      {
+        streamLink = l;
+        deadline = d;
+      }
+    }
+    if(!streamLink)
+      break;
+    streamLink->claimed = 1;
+    if(numDue > 1)
+      gc_event_signal(in_mgr->wakeEvent); /* Let an idle worker take the rest */
+    gc_mutex_unlock(in_mgr->streamListMutex);
+    progress = gaX_stream_link_produce(streamLink, GAX_STREAM_MANAGER_CHUNK_SAMPLES);
+    gc_mutex_lock(in_mgr->streamListMutex);
+    streamLink->claimed = 0;
+    if(progress < 0)
     {
-      gc_mutex_lock(in_mgr->streamListMutex);
       gc_list_unlink((gc_Link*)streamLink);
-      gc_mutex_unlock(in_mgr->streamListMutex);
       gaX_stream_link_release(streamLink);
     }
+    else if(!progress)
+      streamLink->idlePass = pass; /* Stalled (source not ready, or out of mark slots) */
+    if(in_endNs && gc_time_ns() >= in_endNs)
+      break;
   }
+  gc_mutex_unlock(in_mgr->streamListMutex);
+}
+void ga_stream_manager_buffer(ga_StreamManager* in_mgr)
+{
+  gaX_stream_manager_buffer(in_mgr, 0);
+}
+void ga_stream_manager_buffer_budget(ga_StreamManager* in_mgr, gc_uint32 in_budgetUs)
+{
+  if(in_budgetUs)
+    gaX_stream_manager_buffer(in_mgr, gc_time_ns() + (gc_uint64)in_budgetUs * 1000);
+}
+void ga_stream_manager_set_low_watermark(ga_StreamManager* in_mgr, gc_float32 in_fraction)
+{
+  in_mgr->lowWatermark = in_fraction;
+}
+gc_int32 ga_stream_manager_wait(ga_StreamManager* in_mgr, gc_uint32 in_timeoutMs)
+{
+  return gc_event_wait(in_mgr->wakeEvent, in_timeoutMs);
+}
+void ga_stream_manager_wake(ga_StreamManager* in_mgr)
+{
+  gc_event_signal(in_mgr->wakeEvent);
 }
 void ga_stream_manager_destroy(ga_StreamManager* in_mgr)
 {
@@ -182,46 +210,130 @@ void ga_stream_manager_destroy(ga_StreamManager* in_mgr)
     gaX_stream_link_release(oldLink);
   }
   gc_mutex_destroy(in_mgr->streamListMutex);
+  gc_event_destroy(in_mgr->wakeEvent);
   gcX_ops->freeFunc(in_mgr);
 }
 
 /* Stream */
+/* Marks are needed for every loop wrap in the buffered window, so the mark
+   ring grows with the buffer length (one mark per this many samples) */
+#define GAX_STREAM_SAMPLES_PER_MARK 256
+#define GAX_STREAM_MIN_MARKS 16
+#define GAX_STREAM_MAX_MARKS 4096
+/* Fraction of the buffer kept intact behind the read position, so short
+   backward seeks (scrubbing, sync corrections) need not hit the decoder */
+#define GAX_STREAM_HISTORY_DIVISOR 8
+
 ga_BufferedStream* ga_stream_create(ga_StreamManager* in_mgr, ga_SampleSource* in_sampleSrc, gc_int32 in_bufferSize)
 {
-  ga_BufferedStream* ret = gcX_ops->allocFunc(sizeof(ga_BufferedStream));
+  ga_BufferedStream* ret;
+  ga_Format format;
+  gc_uint32 markCapacity = GAX_STREAM_MIN_MARKS;
+  gc_int32 bufferSamples;
+  ga_sample_source_format(in_sampleSrc, &format);
+  bufferSamples = in_bufferSize / ga_format_sampleSize(&format);
+  while(markCapacity < GAX_STREAM_MAX_MARKS && markCapacity * GAX_STREAM_SAMPLES_PER_MARK < (gc_uint32)bufferSamples)
+    markCapacity <<= 1;
+  ret = gcX_ops->allocFunc(sizeof(ga_BufferedStream) + markCapacity * sizeof(gaX_StreamMark));
+  ret->markRing = (gaX_StreamMark*)(ret + 1);
+  ret->markCapacity = markCapacity;
+  ret->markHead = 0;
+  ret->markTail = 0;
   ret->refCount = 1;
-  ret->refMutex = gc_mutex_create();
+  ret->refMutex = gc_mutex_create_named("ga_BufferedStream::refMutex");
   ga_sample_source_acquire(in_sampleSrc);
   ga_sample_source_format(in_sampleSrc, &ret->format);
-  gc_list_head(&ret->tellJumps);
   ret->innerSrc = in_sampleSrc;
-  ret->nextSample = 0;
-  ret->seek = 0;
+  /* Epoch 0 is an implicit seek to sample 0, performed by the first produce */
+  ret->seekEpoch = 0;
+  memset(ret->seekRing, 0, sizeof(ret->seekRing));
+  ret->numUnderruns = 0;
+  ret->startEpoch = -1;
+  ret->startPos = 0;
+  ret->endEpoch = -1;
   ret->tell = 0;
-  ret->end = 0;
+  ret->tellEpoch = -1;
+  ret->produceEpoch = -1;
+  ret->readBase = 0;
+  memset(&ret->writeMark, 0, sizeof(gaX_StreamMark));
+  memset(&ret->readMark, 0, sizeof(gaX_StreamMark));
+  ret->writeMark.epoch = -1;
+  ret->readMark.epoch = -1;
+  ret->readEpoch = 0;
+  ret->validEpoch = 0;
+  ret->readHighWater = 0;
   ret->bufferSize = in_bufferSize;
+  ret->historyBytes = in_bufferSize / GAX_STREAM_HISTORY_DIVISOR;
+  ret->historyBytes -= ret->historyBytes % ga_format_sampleSize(&format);
   ret->flags = ga_sample_source_flags(in_sampleSrc);
   assert(ret->flags & GA_FLAG_THREADSAFE);
-  ret->produceMutex = gc_mutex_create();
-  ret->seekMutex = gc_mutex_create();
-  ret->readMutex = gc_mutex_create();
-  ret->buffer = gc_buffer_create(in_bufferSize);
+  ret->buffer = gc_buffer_create_mirrored(in_bufferSize); /* Falls back to a regular buffer */
+  ret->mgr = in_mgr;
   ret->streamLink = (gc_Link*)gaX_stream_manager_add(in_mgr, ret);
+  ga_stream_manager_wake(in_mgr);
   return ret;
 }
-void gaX_stream_onSeek(gc_int32 in_sample, gc_int32 in_delta, void* in_seekContext)
+
+/* Seek requests */
+static gaX_StreamSeek* gaX_stream_seek_slot(ga_BufferedStream* in_stream, gc_int32 in_epoch)
+{
+  return &in_stream->seekRing[((gc_uint32)in_epoch >> 1) & (GAX_STREAM_SEEK_SLOTS - 1)];
+}
+static gc_int32 gaX_stream_next_seek_epoch(gc_int32 in_epoch)
+{
+  /* The next client request after in_epoch (or after its retry) */
+  return (gc_int32)(((gc_uint32)in_epoch | 1) + 1);
+}
+static gc_int32 gaX_stream_load_seek(ga_BufferedStream* in_stream, gc_int64* out_target, gc_int32* out_soft)
+{
+  /* Returns the latest seek epoch, with its request. A slot is only reused
+     GAX_STREAM_SEEK_SLOTS requests later, so the snapshot is retaken only if
+     that many seeks were requested while it was being read. */
+  ga_BufferedStream* s = in_stream;
+  gc_int32 epoch = gc_atomic_load(&s->seekEpoch);
+  for(;;)
+  {
+    gaX_StreamSeek* slot = gaX_stream_seek_slot(s, epoch);
+    gc_int32 latest;
+    *out_target = gc_atomic_load64(&slot->target);
+    *out_soft = gc_atomic_load(&slot->soft) && !(epoch & 1); /* Retries always seek the decoder */
+    latest = gc_atomic_load(&s->seekEpoch);
+    if((gc_int32)(((gc_uint32)latest >> 1) - ((gc_uint32)epoch >> 1)) < GAX_STREAM_SEEK_SLOTS - 1)
+      return epoch;
+    epoch = latest;
+  }
+}
+
+/* Producer side */
+static gc_uint32 gaX_stream_marks_free(ga_BufferedStream* in_stream)
+{
+  ga_BufferedStream* s = in_stream;
+  return s->markCapacity - (s->markHead - (gc_uint32)gc_atomic_load((volatile gc_int32*)&s->markTail));
+}
+static void gaX_stream_push_mark(ga_BufferedStream* in_stream, gc_uint32 in_bytePos, gc_int64 in_sample)
+{
+  ga_BufferedStream* s = in_stream;
+  gaX_StreamMark mark;
+  mark.bytePos = in_bytePos;
+  mark.epoch = s->produceEpoch;
+  mark.sample = in_sample;
+  /* The producer keeps free slots before each read, so this only fails for
+     loops shorter than GAX_STREAM_SAMPLES_PER_MARK; the mark is then lost, and
+     tell() is off by the loop delta until the next mark */
+  if(gaX_stream_marks_free(s))
+  {
+    s->markRing[s->markHead & (s->markCapacity - 1)] = mark;
+    gc_atomic_store((volatile gc_int32*)&s->markHead, (gc_int32)(s->markHead + 1));
+  }
+  s->writeMark = mark;
+}
+void gaX_stream_onSeek(gc_int64 in_sample, gc_int64 in_delta, void* in_seekContext)
 {
   ga_BufferedStream* s = (ga_BufferedStream*)in_seekContext;
-  gc_int32 samplesAvail, sampleSize;
-  ga_Format fmt;
-  ga_sample_source_format(s->innerSrc, &fmt);
-  sampleSize = ga_format_sampleSize(&fmt);
-  gc_mutex_lock(s->readMutex);
-  gc_mutex_lock(s->seekMutex);
-  samplesAvail = gc_buffer_bytesAvail(s->buffer) / sampleSize;
-  gauX_tell_jump_push(&s->tellJumps, samplesAvail + in_sample, in_delta);
-  gc_mutex_unlock(s->seekMutex);
-  gc_mutex_unlock(s->readMutex);
+  gc_int32 sampleSize = ga_format_sampleSize(&s->format);
+  gc_uint32 bytePos = s->readBase + (gc_uint32)in_sample * sampleSize;
+  gc_int64 sample = s->writeMark.sample + (gc_int32)(bytePos - s->writeMark.bytePos) / sampleSize;
+  gaX_stream_push_mark(s, bytePos, sample + in_delta);
 }
 gc_int32 gaX_read_samples_into_stream(ga_BufferedStream* in_stream,
                                       gc_CircBuffer* in_buffer,
@@ -234,135 +346,395 @@ gc_int32 gaX_read_samples_into_stream(ga_BufferedStream* in_stream,
   gc_uint32 sizeB = 0;
   gc_int32 numBuffers;
   gc_int32 numWritten = 0;
-  ga_Format fmt;
-  gc_int32 sampleSize;
+  gc_int32 sampleSize = ga_format_sampleSize(&in_stream->format);
   gc_CircBuffer* b = in_buffer;
-  ga_sample_source_format(in_sampleSrc, &fmt);
-  sampleSize = ga_format_sampleSize(&fmt);
   numBuffers = gc_buffer_getFree(b, in_samples * sampleSize, &dataA, &sizeA, &dataB, &sizeB);
   if(numBuffers >= 1)
   {
+    in_stream->readBase = b->nextFree;
     numWritten = ga_sample_source_read(in_sampleSrc, dataA, sizeA / sampleSize, &gaX_stream_onSeek, in_stream);
-    if(numBuffers == 2 && numWritten == sizeA)
+    if(numBuffers == 2 && numWritten == (gc_int32)(sizeA / sampleSize))
+    {
+      in_stream->readBase = b->nextFree + sizeA;
       numWritten += ga_sample_source_read(in_sampleSrc, dataB, sizeB / sampleSize, &gaX_stream_onSeek, in_stream);
+    }
   }
   gc_buffer_produce(b, numWritten * sampleSize);
   return numWritten;
 }
-void ga_stream_produce(ga_BufferedStream* in_stream)
+static gc_int32 gaX_stream_produce(ga_BufferedStream* in_stream, gc_int32 in_maxBytes)
 {
+  /* Produces up to in_maxBytes. Returns non-zero if any progress was made
+     (data produced or a seek handled). */
   ga_BufferedStream* s = in_stream;
   gc_CircBuffer* b = s->buffer;
   gc_int32 sampleSize = ga_format_sampleSize(&s->format);
-  gc_int32 bytesFree = gc_buffer_bytesFree(b);
-  if(s->seek >= 0)
+  gc_int32 bytesFree;
+  gc_int32 progress = 0;
+  gc_int64 target;
+  gc_int32 soft;
+  gc_int32 epoch = gaX_stream_load_seek(s, &target, &soft);
+  if(epoch != s->produceEpoch && soft)
   {
-    gc_int32 samplePos;
-    gc_mutex_lock(s->readMutex);
-    gc_mutex_lock(s->seekMutex);
-    if(s->seek >= 0) /* Check again now that we're mutexed */
-    {
-      samplePos = s->seek;
-      s->tell = samplePos;
-      s->seek = -1;
-      s->nextSample = samplePos;
-      ga_sample_source_seek(s->innerSrc, samplePos);
-      gc_buffer_consume(s->buffer, gc_buffer_bytesAvail(s->buffer)); /* Clear buffer */
-      gauX_tell_jump_clear(&s->tellJumps); /* Clear tell-jump list */
-    }
-    gc_mutex_unlock(s->seekMutex);
-    gc_mutex_unlock(s->readMutex);
+    /* The consumer serves this seek from buffered data (or requests a full
+       seek if it can't), so keep producing where we are */
+    if(gc_atomic_load(&s->endEpoch) == s->produceEpoch)
+      gc_atomic_store(&s->endEpoch, epoch);
+    s->produceEpoch = epoch;
+    gc_atomic_store((volatile gc_int32*)&s->startPos, (gc_int32)(b->nextFree - b->dataSize));
+    gc_atomic_store(&s->startEpoch, epoch);
+    progress = 1;
   }
+  else if(epoch != s->produceEpoch)
+  {
+    /* A seek was requested. Buffered data from older epochs is dropped by
+       the consumer; the mark tells it where the new data starts. */
+    if(!gaX_stream_marks_free(s))
+      return 0; /* Retry once the consumer has caught up */
+    ga_sample_source_seek64(s->innerSrc, target);
+    s->produceEpoch = epoch;
+    gaX_stream_push_mark(s, b->nextFree, target);
+    gc_atomic_store((volatile gc_int32*)&s->startPos, (gc_int32)b->nextFree);
+    gc_atomic_store(&s->startEpoch, epoch);
+    progress = 1;
+  }
+  if(gc_atomic_load(&s->endEpoch) == s->produceEpoch)
+    return progress;
 
-  while(bytesFree)
+  /* Leave the history window behind the read position intact */
+  bytesFree = (gc_int32)gc_buffer_bytesFree(b) - s->historyBytes;
+  bytesFree = bytesFree > in_maxBytes ? in_maxBytes - in_maxBytes % sampleSize : bytesFree;
+  while(bytesFree > 0)
   {
     gc_int32 samplesWritten = 0;
     gc_int32 bytesWritten = 0;
     gc_int32 bytesToWrite = bytesFree;
+    gc_int32 marksFree = (gc_int32)gaX_stream_marks_free(s);
+    gc_int32 maxBytes;
+    if(marksFree < 2)
+      break; /* The consumer frees mark slots as it reads */
+    /* Read no more than the free mark slots can describe (one loop wrap per
+       GAX_STREAM_SAMPLES_PER_MARK samples), keeping one slot for a seek */
+    maxBytes = (marksFree - 1) * GAX_STREAM_SAMPLES_PER_MARK * sampleSize;
+    bytesToWrite = bytesToWrite > maxBytes ? maxBytes : bytesToWrite;
     samplesWritten = gaX_read_samples_into_stream(s, b, bytesToWrite / sampleSize, s->innerSrc);
     bytesWritten = samplesWritten * sampleSize;
     bytesFree -= bytesWritten;
-    s->nextSample += samplesWritten;
+    progress |= bytesWritten > 0;
     if(bytesWritten < bytesToWrite && ga_sample_source_end(s->innerSrc))
     {
-      s->end = 1;
+      gc_atomic_store(&s->endEpoch, s->produceEpoch);
+      progress = 1;
       break;
     }
+    if(!bytesWritten)
+      break; /* Source not ready */
   }
+  return progress;
 }
-gc_int32 ga_stream_read(ga_BufferedStream* in_stream, void* in_dst, gc_int32 in_numSamples)
+void ga_stream_produce(ga_BufferedStream* in_stream)
+{
+  gaX_stream_produce(in_stream, 0x7fffffff);
+}
+static gc_float32 gaX_stream_deadline(ga_BufferedStream* in_stream, gc_int32 in_chunkBytes)
 {
+  /* Time (in seconds) until the consumer drains the buffer, or -1 if there is
+     nothing worth producing. The buffer is assumed to drain at the stream's
+     sample rate. */
   ga_BufferedStream* s = in_stream;
   gc_CircBuffer* b = s->buffer;
-  gc_int32 delta;
+  gc_int32 sampleSize = ga_format_sampleSize(&s->format);
+  gc_int32 usable = s->bufferSize - s->historyBytes;
+  gc_int32 bytesFree;
+  gc_uint32 nextAvail, nextFree;
+  if(gc_atomic_load(&s->seekEpoch) != s->produceEpoch)
+    return 0.0f; /* Seek pending: the consumer is already starving */
+  if(gc_atomic_load(&s->endEpoch) == s->produceEpoch)
+    return -1.0f;
+  nextAvail = (gc_uint32)gc_atomic_load((volatile gc_int32*)&b->nextAvail);
+  nextFree = b->nextFree;
+  bytesFree = (gc_int32)gc_buffer_bytesFree(b) - s->historyBytes;
+  /* Skip nearly-full buffers, rather than topping them up a few bytes at a time */
+  if(bytesFree < (in_chunkBytes < usable / 4 ? in_chunkBytes : usable / 4))
+    return -1.0f;
+  return (gc_int32)(nextFree - nextAvail) / (gc_float32)(sampleSize * s->format.sampleRate);
+}
 
-  /* Read the samples */
-  gc_int32 samplesConsumed = 0;
-  gc_mutex_lock(s->readMutex);
+/* Consumer side */
+static gc_int32 gaX_stream_marks_valid(ga_BufferedStream* in_stream, gaX_StreamMark* in_mark)
+{
+  return (gc_int32)(in_mark->epoch - in_stream->validEpoch) >= 0;
+}
+static void gaX_stream_adopt_marks(ga_BufferedStream* in_stream, gc_uint32 in_end)
+{
+  /* Adopts the marks the read position has reached, dropping stale data in
+     front of them */
+  ga_BufferedStream* s = in_stream;
+  gc_CircBuffer* b = s->buffer;
+  gaX_StreamMark mark;
+  while(s->markTail != (gc_uint32)gc_atomic_load((volatile gc_int32*)&s->markHead))
   {
-    void* dataA;
-    void* dataB;
-    gc_uint32 sizeA, sizeB;
-    gc_int32 totalBytes = 0;
-    gc_int32 sampleSize = ga_format_sampleSize(&s->format);
-    gc_int32 dstBytes = in_numSamples * sampleSize;
-    gc_int32 avail = gc_buffer_bytesAvail(b);
-    dstBytes = dstBytes > avail ? avail : dstBytes;
-    if(gc_buffer_getAvail(b, dstBytes, &dataA, &sizeA, &dataB, &sizeB) >= 1)
+    gc_int32 ahead;
+    mark = s->markRing[s->markTail & (s->markCapacity - 1)];
+    if((gc_int32)(mark.bytePos - in_end) > 0)
+      break; /* Loop mark for data that has not been produced yet */
+    ahead = (gc_int32)(mark.bytePos - b->nextAvail);
+    if(ahead > 0)
     {
-      gc_int32 bytesToRead = dstBytes < (gc_int32)sizeA ? dstBytes : (gc_int32)sizeA;
-      memcpy(in_dst, dataA, bytesToRead);
-      totalBytes += bytesToRead;
-      if(dstBytes > 0 && dataB)
-      {
-        gc_int32 dstBytesLeft = dstBytes - bytesToRead;
-        bytesToRead = dstBytesLeft < (gc_int32)sizeB ? dstBytesLeft : (gc_int32)sizeB;
-        memcpy((char*)in_dst + totalBytes, dataB, bytesToRead);
-        totalBytes += bytesToRead;
-      }
+      if(gaX_stream_marks_valid(s, &s->readMark))
+        break;
+      gc_buffer_consume(b, ahead); /* Stale */
     }
-    samplesConsumed = totalBytes / sampleSize;
-    gc_buffer_consume(b, totalBytes);
+    s->readMark = mark;
+    gc_atomic_store((volatile gc_int32*)&s->markTail, (gc_int32)(s->markTail + 1));
   }
-
-  /* Update the tell pos */
-  gc_mutex_lock(s->seekMutex);
-  s->tell += samplesConsumed;
-  delta = gauX_tell_jump_process(&s->tellJumps, samplesConsumed);
-  s->tell += delta;
-  gc_mutex_unlock(s->seekMutex);
-  gc_mutex_unlock(s->readMutex);
+}
+static gc_int32 gaX_stream_seek_buffered(ga_BufferedStream* in_stream, gc_int64 in_sampleOffset, gc_uint32 in_end)
+{
+  /* Moves the read position to in_sampleOffset if it lies in the buffered
+     data of the current mark's segment (ahead of the read position, or in
+     the history window behind it). Returns 1 on success. */
+  ga_BufferedStream* s = in_stream;
+  gc_CircBuffer* b = s->buffer;
+  gc_int32 sampleSize = ga_format_sampleSize(&s->format);
+  gc_int64 tell;
+  gc_int64 bytes;
+  gc_uint32 limit;
+  if(!gaX_stream_marks_valid(s, &s->readMark))
+    return 0;
+  if((gc_int32)(b->nextAvail - s->readHighWater) > 0)
+    s->readHighWater = b->nextAvail;
+  tell = s->readMark.sample + (gc_int32)(b->nextAvail - s->readMark.bytePos) / sampleSize;
+  if(in_sampleOffset >= tell)
+  {
+    bytes = (in_sampleOffset - tell) * sampleSize;
+    limit = in_end - b->nextAvail;
+    if(s->markTail != (gc_uint32)gc_atomic_load((volatile gc_int32*)&s->markHead))
+    {
+      /* Data from the next mark on belongs to another segment */
+      gaX_StreamMark* next = &s->markRing[s->markTail & (s->markCapacity - 1)];
+      if((gc_int32)(next->bytePos - in_end) < 0)
+        limit = next->bytePos - b->nextAvail - 1;
+    }
+    if(bytes > limit)
+      return 0;
+    gc_buffer_consume(b, (gc_uint32)bytes);
+  }
+  else
+  {
+    /* The producer keeps historyBytes behind the furthest position it may
+       have seen read, not behind this one: after a backward seek, part of
+       the history window has already been used up */
+    gc_int32 history = s->historyBytes - (gc_int32)(s->readHighWater - b->nextAvail);
+    bytes = (tell - in_sampleOffset) * sampleSize;
+    limit = b->nextAvail - s->readMark.bytePos;
+    history = history > 0 ? history : 0;
+    limit = limit > (gc_uint32)history ? (gc_uint32)history : limit;
+    if(bytes > limit)
+      return 0;
+    gc_buffer_unconsume(b, (gc_uint32)bytes);
+  }
+  return 1;
+}
+static gc_int32 gaX_stream_sync(ga_BufferedStream* in_stream)
+{
+  /* Handles new seek requests, adopts the marks the read position has
+     reached, and drops data from epochs older than the latest full seek.
+     Returns the number of readable bytes (0 while a seek is pending). */
+  ga_BufferedStream* s = in_stream;
+  gc_CircBuffer* b = s->buffer;
+  gc_int32 sampleSize = ga_format_sampleSize(&s->format);
+  gc_int64 target;
+  gc_int32 soft;
+  gc_int32 epoch = gaX_stream_load_seek(s, &target, &soft);
+  /* Load the data bounds before the marks: a mark is always published before
+     the data it applies to */
+  gc_uint32 end = b->nextAvail + gc_buffer_bytesAvail(b);
+  gaX_stream_adopt_marks(s, end);
+  if(epoch != s->readEpoch)
+  {
+    if(soft && (epoch != gaX_stream_next_seek_epoch(s->readEpoch) ||
+                !gaX_stream_seek_buffered(s, target, end)))
+    {
+      /* Not in the buffer (or requests were skipped): retry the request as
+         a decoder seek. The retry only reuses the request's slot, so it
+         can't overwrite a newer seek; if one has arrived, the next sync
+         handles that instead. */
+      gc_int32 retry = epoch | 1;
+      ga_stream_manager_wake(s->mgr);
+      if(gc_atomic_cas(&s->seekEpoch, epoch, retry) != epoch)
+        return 0;
+      epoch = retry;
+      soft = 0;
+    }
+    if(!soft)
+      s->validEpoch = epoch;
+    s->readEpoch = epoch;
+    gaX_stream_adopt_marks(s, end);
+  }
+  if(!gaX_stream_marks_valid(s, &s->readMark))
+  {
+    /* Everything buffered predates the seek */
+    gc_buffer_consume(b, end - b->nextAvail);
+    return 0;
+  }
+  gc_atomic_store64(&s->tell, s->readMark.sample + (gc_int32)(b->nextAvail - s->readMark.bytePos) / sampleSize);
+  gc_atomic_store(&s->tellEpoch, s->readEpoch);
+  return gc_buffer_bytesAvail(b);
+}
+gc_int32 ga_stream_read(ga_BufferedStream* in_stream, void* in_dst, gc_int32 in_numSamples)
+{
+  ga_BufferedStream* s = in_stream;
+  void* dataA;
+  void* dataB;
+  gc_int32 samplesA, samplesB;
+  gc_int32 sampleSize = ga_format_sampleSize(&s->format);
+  gc_int32 samplesConsumed = ga_stream_peek(s, in_numSamples, &dataA, &samplesA, &dataB, &samplesB);
+  if(samplesA)
+    memcpy(in_dst, dataA, samplesA * sampleSize);
+  if(samplesB)
+    memcpy((char*)in_dst + samplesA * sampleSize, dataB, samplesB * sampleSize);
+  ga_stream_commit(s, samplesConsumed);
   return samplesConsumed;
 }
+gc_int32 ga_stream_peek(ga_BufferedStream* in_stream, gc_int32 in_numSamples,
+                        void** out_dataA, gc_int32* out_samplesA,
+                        void** out_dataB, gc_int32* out_samplesB)
+{
+  /* consumer-only call */
+  ga_BufferedStream* s = in_stream;
+  gc_CircBuffer* b = s->buffer;
+  void* dataA = 0;
+  void* dataB = 0;
+  gc_uint32 sizeA = 0;
+  gc_uint32 sizeB = 0;
+  gc_int32 sampleSize = ga_format_sampleSize(&s->format);
+  gc_int32 bytes = in_numSamples * sampleSize;
+  gc_int32 playing = s->tellEpoch == gc_atomic_load(&s->seekEpoch);
+  gc_int32 avail = gaX_stream_sync(s);
+  if(bytes > avail && playing && gc_atomic_load(&s->endEpoch) != s->readEpoch)
+    gc_atomic_add(&s->numUnderruns, 1); /* The reader gets less than it needs to keep playing */
+  bytes = bytes > avail ? avail : bytes;
+  if(bytes <= 0 || gc_buffer_getAvail(b, bytes, &dataA, &sizeA, &dataB, &sizeB) < 1)
+    sizeA = sizeB = 0;
+  *out_dataA = dataA;
+  *out_samplesA = sizeA / sampleSize;
+  *out_dataB = sizeB ? dataB : 0;
+  *out_samplesB = sizeB / sampleSize;
+  return *out_samplesA + *out_samplesB;
+}
+void ga_stream_commit(ga_BufferedStream* in_stream, gc_int32 in_numSamples)
+{
+  /* consumer-only call */
+  ga_BufferedStream* s = in_stream;
+  gc_int32 avail;
+  gc_buffer_consume(s->buffer, in_numSamples * ga_format_sampleSize(&s->format));
+  avail = gaX_stream_sync(s); /* Adopt passed marks and publish the new tell position */
+  if(avail < s->mgr->lowWatermark * s->bufferSize && gc_atomic_load(&s->endEpoch) != s->readEpoch)
+    ga_stream_manager_wake(s->mgr);
+}
+static gc_int32 gaX_stream_bytesReady(ga_BufferedStream* in_stream)
+{
+  /* Readable bytes from the latest seek epoch, or -1 while a seek is pending.
+     Only uses published state, so it may be called from any thread (e.g.
+     through ga_handle_ready()). A seek that may be served from buffered data
+     is not pending; the consumer resolves it on its next read. */
+  ga_BufferedStream* s = in_stream;
+  gc_CircBuffer* b = s->buffer;
+  gc_int64 target;
+  gc_int32 soft;
+  gc_int32 epoch = gaX_stream_load_seek(s, &target, &soft);
+  gc_uint32 start, nextAvail, nextFree;
+  gc_int32 started = gc_atomic_load(&s->startEpoch) == epoch;
+  if(!started && !soft)
+    return -1;
+  start = (gc_uint32)gc_atomic_load((volatile gc_int32*)&s->startPos);
+  nextAvail = (gc_uint32)gc_atomic_load((volatile gc_int32*)&b->nextAvail);
+  nextFree = (gc_uint32)gc_atomic_load((volatile gc_int32*)&b->nextFree);
+  if(started && (gc_int32)(start - nextAvail) > 0)
+    nextAvail = start; /* Stale data not dropped by the consumer yet */
+  return (gc_int32)(nextFree - nextAvail) > 0 ? (gc_int32)(nextFree - nextAvail) : 0;
+}
 gc_int32 ga_stream_ready(ga_BufferedStream* in_stream, gc_int32 in_numSamples)
 {
   ga_BufferedStream* s = in_stream;
-  gc_int32 avail = gc_buffer_bytesAvail(s->buffer);
-  return s->end || avail >= in_numSamples * ga_format_sampleSize(&s->format) && avail > s->bufferSize / 2.0f;
+  gc_int32 avail = gaX_stream_bytesReady(s);
+  gc_int32 needed = in_numSamples * ga_format_sampleSize(&s->format);
+  if(avail < 0)
+    return 0;
+  if(gc_atomic_load(&s->endEpoch) == gc_atomic_load(&s->startEpoch))
+    return 1;
+  if(gc_atomic_load(&s->tellEpoch) == gc_atomic_load(&s->seekEpoch))
+    return 1; /* Already playing: the reader takes what is buffered, and ga_stream_peek() counts any shortfall */
+  return avail >= needed && avail > s->bufferSize / 2.0f;
 }
 gc_int32 ga_stream_end(ga_BufferedStream* in_stream)
 {
   ga_BufferedStream* s = in_stream;
-  gc_CircBuffer* b = s->buffer;
-  gc_int32 bytesAvail = gc_buffer_bytesAvail(b);
-  return s->end && bytesAvail == 0;
+  gc_int32 epoch = gc_atomic_load(&s->seekEpoch);
+  gc_int32 bytesAvail = gaX_stream_bytesReady(s);
+  if(gc_atomic_load(&s->startEpoch) != epoch || gc_atomic_load(&s->tellEpoch) != epoch)
+    return 0; /* Seek not resolved yet; it may land in the history window */
+  return bytesAvail == 0 && gc_atomic_load(&s->endEpoch) == epoch;
+}
+gc_int32 ga_stream_underruns(ga_BufferedStream* in_stream)
+{
+  return gc_atomic_load(&in_stream->numUnderruns);
 }
 gc_int32 ga_stream_seek(ga_BufferedStream* in_stream, gc_int32 in_sampleOffset)
 {
+  return ga_stream_seek64(in_stream, in_sampleOffset);
+}
+gc_int32 ga_stream_seek64(ga_BufferedStream* in_stream, gc_int64 in_sampleOffset)
+{
+  /* Seeks near the last published position may be served from buffered
+     data; the consumer falls back to seeking the decoder if they can't.
+     The request is written to its slot before its epoch is published. The
+     consumer only ever retries the current request (turning its even epoch
+     odd), so the CAS fails only if that happened in between. */
   ga_BufferedStream* s = in_stream;
-  gc_mutex_lock(s->seekMutex);
-  s->seek = in_sampleOffset;
-  gc_mutex_unlock(s->seekMutex);
+  gc_int32 sampleSize = ga_format_sampleSize(&s->format);
+  gc_int32 epoch = gc_atomic_load(&s->seekEpoch);
+  for(;;)
+  {
+    gc_int32 next = gaX_stream_next_seek_epoch(epoch);
+    gaX_StreamSeek* slot = gaX_stream_seek_slot(s, next);
+    gc_int32 soft = 0;
+    gc_int32 prev;
+    if(gc_atomic_load(&s->tellEpoch) == epoch)
+    {
+      gc_int64 delta = in_sampleOffset - gc_atomic_load64(&s->tell);
+      soft = delta >= -s->historyBytes / sampleSize && delta < s->bufferSize / sampleSize;
+    }
+    gc_atomic_store64(&slot->target, in_sampleOffset);
+    gc_atomic_store(&slot->soft, soft);
+    prev = gc_atomic_cas(&s->seekEpoch, epoch, next);
+    if(prev == epoch)
+      break;
+    epoch = prev;
+  }
+  ga_stream_manager_wake(s->mgr);
   return 0;
 }
 gc_int32 ga_stream_tell(ga_BufferedStream* in_stream, gc_int32* out_totalSamples)
+{
+  gc_int64 total;
+  gc_int64 ret = ga_stream_tell64(in_stream, &total);
+  if(out_totalSamples)
+    *out_totalSamples = gaX_clamp32(total);
+  return gaX_clamp32(ret);
+}
+gc_int64 ga_stream_tell64(ga_BufferedStream* in_stream, gc_int64* out_totalSamples)
 {
   ga_BufferedStream* s = in_stream;
-  gc_int32 ret = -1;
-  ga_sample_source_tell(s->innerSrc, out_totalSamples);
-  gc_mutex_lock(s->seekMutex);
-  ret = s->seek >= 0 ? s->seek : s->tell;
-  gc_mutex_unlock(s->seekMutex);
+  gc_int64 target;
+  gc_int32 soft;
+  gc_int32 epoch = gaX_stream_load_seek(s, &target, &soft);
+  gc_int32 tellEpoch = gc_atomic_load(&s->tellEpoch);
+  gc_int64 ret = gc_atomic_load64(&s->tell);
+  ga_sample_source_tell64(s->innerSrc, out_totalSamples);
+  if(tellEpoch != epoch)
+    ret = target; /* Seek still pending */
   return ret;
 }
 gc_int32 ga_stream_flags(ga_BufferedStream* in_stream)
@@ -375,12 +747,8 @@ void gaX_stream_destroy(ga_BufferedStream* in_stream)
   ga_BufferedStream* s = in_stream;
   gaX_stream_link_kill((gaX_StreamLink*)s->streamLink); /* This must be done first, so that the stream remains valid until it killed */
   gaX_stream_link_release((gaX_StreamLink*)s->streamLink);
-  gc_mutex_destroy(s->produceMutex);
-  gc_mutex_destroy(s->seekMutex);
-  gc_mutex_destroy(s->readMutex);
   gc_mutex_destroy(s->refMutex);
   gc_buffer_destroy(s->buffer);
-  gauX_tell_jump_clear(&s->tellJumps);
   ga_sample_source_release(s->innerSrc);
   gcX_ops->freeFunc(s);
 }
@@ -20,7 +20,8 @@
 typedef struct gau_Manager {
   gc_int32 threadPolicy;
   gc_Thread* mixThread;
-  gc_Thread* streamThread;
+  gc_Thread** streamThreads;
+  gc_int32 numStreamThreads;
   ga_Device* device;
   ga_Mixer* mixer;
   ga_StreamManager* streamMgr;
@@ -28,6 +29,11 @@ typedef struct gau_Manager {
   gc_int16* mixBuffer;
   ga_Format format;
   gc_int32 killThreads;
+  gc_int64 budgetDebtUs; /* Budget overrun carried over to the next gau_manager_update_budget() */
+  gau_JobSystem jobSystem;
+  void** jobs; /* Jobs submitted by the last update: mix job, then stream jobs */
+  gc_int32 numStreamJobs;
+  gc_int32 jobsPending;
 } gau_Manager;
 
 static gc_int32 gauX_mixThreadFunc(void* in_context)
@@ -35,6 +41,7 @@ static gc_int32 gauX_mixThreadFunc(void* in_context)
   gau_Manager* ctx = (gau_Manager*)in_context;
   ga_Mixer* m = ctx->mixer;
   gc_int32 sampleSize = ga_format_sampleSize(&ctx->format);
+  gc_realtime_thread_set(GC_TRUE);
   while(!ctx->killThreads)
   {
     gc_int32 numToQueue = ga_device_check(ctx->device);
@@ -54,22 +61,35 @@ static gc_int32 gauX_streamThreadFunc(void* in_context)
   while(!ctx->killThreads)
   {
     ga_stream_manager_buffer(mgr);
-    gc_thread_sleep(50);
+    ga_stream_manager_wait(mgr, 50); /* Streams wake us up when they run low */
   }
+  ga_stream_manager_wake(mgr); /* Pass the shutdown on to the other workers */
   return 0;
 }
 gau_Manager* gau_manager_create()
 {
   gau_Manager* ret;
-  ret = gau_manager_create_custom(GA_DEVICE_TYPE_DEFAULT, GAU_THREAD_POLICY_SINGLE, 4, 512);
+  ret = gau_manager_create_custom(GA_DEVICE_TYPE_DEFAULT, GAU_THREAD_POLICY_SINGLE, 4, 512, 0, 0, 1);
   return ret;
 }
+void gau_manager_thread_params_default(gc_ThreadParams* out_params)
+{
+  gc_thread_params_default(out_params);
+  out_params->priority = GC_THREAD_PRIORITY_HIGH;
+  out_params->stackSize = 256 * 1024; /* Leave room for the decoders' stack use */
+}
 gau_Manager* gau_manager_create_custom(gc_int32 in_devType,
                                        gc_int32 in_threadPolicy,
                                        gc_int32 in_numBuffers,
-                                       gc_int32 in_bufferSamples)
+                                       gc_int32 in_bufferSamples,
+                                       gc_ThreadParams* in_mixThreadParams,
+                                       gc_ThreadParams* in_streamThreadParams,
+                                       gc_int32 in_numStreamThreads)
 {
   gau_Manager* ret = gcX_ops->allocFunc(sizeof(gau_Manager));
+  gc_ThreadParams mixParams;
+  gc_ThreadParams streamParams;
+  gc_int32 i;
 
   assert(in_threadPolicy == GAU_THREAD_POLICY_SINGLE ||
          in_threadPolicy == GAU_THREAD_POLICY_MULTI);
@@ -88,42 +108,164 @@ gau_Manager* gau_manager_create_custom(gc_int32 in_devType,
   ret->mixer = ga_mixer_create(&ret->format, in_bufferSamples);
   ret->streamMgr = ga_stream_manager_create();
   ret->sampleSize = ga_format_sampleSize(&ret->format);
-  ret->mixBuffer = (gc_int16*)gcX_ops->allocFunc(ret->mixer->numSamples * ret->sampleSize);
+  ret->mixBuffer = (gc_int16*)gc_realtime_alloc(ret->mixer->numSamples * ret->sampleSize);
 
   /* Create and run mixer and stream threads */
   ret->threadPolicy = in_threadPolicy;
   ret->killThreads = 0;
+  ret->budgetDebtUs = 0;
+  ret->jobs = 0;
+  ret->numStreamJobs = 0;
+  ret->jobsPending = 0;
   if(ret->threadPolicy == GAU_THREAD_POLICY_MULTI)
   {
-    ret->mixThread = gc_thread_create(gauX_mixThreadFunc, ret, GC_THREAD_PRIORITY_HIGH, 64 * 1024);
-    ret->streamThread = gc_thread_create(gauX_streamThreadFunc, ret, GC_THREAD_PRIORITY_HIGH, 64 * 1024);
+    if(in_mixThreadParams)
+      mixParams = *in_mixThreadParams;
+    else
+      gau_manager_thread_params_default(&mixParams);
+    if(in_streamThreadParams)
+      streamParams = *in_streamThreadParams;
+    else
+      gau_manager_thread_params_default(&streamParams);
+    ret->numStreamThreads = in_numStreamThreads > 0 ? in_numStreamThreads : 1;
+    ret->streamThreads = (gc_Thread**)gcX_ops->allocFunc(ret->numStreamThreads * sizeof(gc_Thread*));
+    ret->mixThread = gc_thread_create_custom(gauX_mixThreadFunc, ret, &mixParams);
+    for(i = 0; ret->mixThread && i < ret->numStreamThreads; ++i)
+    {
+      ret->streamThreads[i] = gc_thread_create_custom(gauX_streamThreadFunc, ret, &streamParams);
+      if(!ret->streamThreads[i])
+        break;
+    }
+    if(!ret->mixThread || i < ret->numStreamThreads)
+    {
+      /* A thread was rejected (e.g. an invalid priority). The created ones
+         are suspended; release them so they see killThreads and exit. */
+      gc_int32 numCreated = ret->mixThread ? i : 0;
+      ret->killThreads = 1;
+      for(i = 0; i < numCreated; ++i)
+      {
+        gc_thread_run(ret->streamThreads[i]);
+        gc_thread_join(ret->streamThreads[i]);
+        gc_thread_destroy(ret->streamThreads[i]);
+      }
+      if(ret->mixThread)
+      {
+        gc_thread_run(ret->mixThread);
+        gc_thread_join(ret->mixThread);
+        gc_thread_destroy(ret->mixThread);
+      }
+      gcX_ops->freeFunc(ret->streamThreads);
+      ga_stream_manager_destroy(ret->streamMgr);
+      ga_mixer_destroy(ret->mixer);
+      gc_realtime_free(ret->mixBuffer);
+      ga_device_close(ret->device);
+      gcX_ops->freeFunc(ret);
+      return 0;
+    }
     gc_thread_run(ret->mixThread);
-    gc_thread_run(ret->streamThread);
+    for(i = 0; i < ret->numStreamThreads; ++i)
+      gc_thread_run(ret->streamThreads[i]);
   }
   else
   {
     ret->mixThread = 0;
-    ret->streamThread = 0;
+    ret->streamThreads = 0;
+    ret->numStreamThreads = 0;
   }
 
   return ret;
 }
+static void gauX_manager_mix(gau_Manager* in_mgr)
+{
+  gc_int16* buf = in_mgr->mixBuffer;
+  ga_Mixer* mixer = in_mgr->mixer;
+  ga_Device* dev = in_mgr->device;
+  gc_int32 numToQueue = ga_device_check(dev);
+  gc_int32 wasRealtime = gc_realtime_thread_set(GC_TRUE);
+  while(numToQueue--)
+  {
+    ga_mixer_mix(mixer, buf);
+    ga_device_queue(dev, buf);
+  }
+  gc_realtime_thread_set(wasRealtime);
+}
+gau_Manager* gau_manager_create_jobs(gc_int32 in_devType,
+                                     gc_int32 in_numBuffers,
+                                     gc_int32 in_bufferSamples,
+                                     gau_JobSystem* in_jobSystem,
+                                     gc_int32 in_numStreamJobs)
+{
+  gau_Manager* ret = gau_manager_create_custom(in_devType, GAU_THREAD_POLICY_SINGLE,
+                                               in_numBuffers, in_bufferSamples, 0, 0, 0);
+  ret->threadPolicy = GAU_THREAD_POLICY_JOBS;
+  ret->jobSystem = *in_jobSystem;
+  ret->numStreamJobs = in_numStreamJobs > 0 ? in_numStreamJobs : 1;
+  ret->jobs = (void**)gcX_ops->allocFunc((1 + ret->numStreamJobs) * sizeof(void*));
+  return ret;
+}
+static void gauX_mixJobFunc(void* in_context)
+{
+  gauX_manager_mix((gau_Manager*)in_context);
+}
+static void gauX_streamJobFunc(void* in_context)
+{
+  gau_Manager* ctx = (gau_Manager*)in_context;
+  ga_stream_manager_buffer(ctx->streamMgr);
+}
+static void gauX_manager_wait_jobs(gau_Manager* in_mgr)
+{
+  gau_JobSystem* js = &in_mgr->jobSystem;
+  gc_int32 i;
+  if(!in_mgr->jobsPending)
+    return;
+  for(i = 0; i < 1 + in_mgr->numStreamJobs; ++i)
+    js->waitFunc(in_mgr->jobs[i], js->userContext);
+  in_mgr->jobsPending = 0;
+}
 void gau_manager_update(gau_Manager* in_mgr)
 {
   if(in_mgr->threadPolicy == GAU_THREAD_POLICY_SINGLE)
   {
-    gc_int16* buf = in_mgr->mixBuffer;
-    ga_Mixer* mixer = in_mgr->mixer;
-    ga_Device* dev = in_mgr->device;
-    ga_Format* fmt = &in_mgr->format;
-    gc_int32 numToQueue = ga_device_check(dev);
-    while(numToQueue--)
-    {
-      ga_mixer_mix(mixer, buf);
-      ga_device_queue(dev, buf);
-    }
+    gauX_manager_mix(in_mgr);
     ga_stream_manager_buffer(in_mgr->streamMgr);
   }
+  else if(in_mgr->threadPolicy == GAU_THREAD_POLICY_JOBS)
+  {
+    /* Jobs run between updates, overlapping with the caller's frame */
+    gau_JobSystem* js = &in_mgr->jobSystem;
+    gc_int32 i;
+    gauX_manager_wait_jobs(in_mgr);
+    in_mgr->jobs[0] = js->submitFunc(&gauX_mixJobFunc, in_mgr, js->userContext);
+    for(i = 0; i < in_mgr->numStreamJobs; ++i)
+      in_mgr->jobs[1 + i] = js->submitFunc(&gauX_streamJobFunc, in_mgr, js->userContext);
+    in_mgr->jobsPending = 1;
+  }
+  ga_mixer_dispatch(in_mgr->mixer);
+}
+void gau_manager_update_budget(gau_Manager* in_mgr, gc_uint32 in_budgetUs)
+{
+  if(in_mgr->threadPolicy != GAU_THREAD_POLICY_SINGLE)
+  {
+    gau_manager_update(in_mgr);
+    return;
+  }
+  {
+    /* Mixing comes first (the device must not starve); streams get what is
+       left, minus what the previous update overran */
+    gc_uint64 start = gc_time_ns();
+    gc_int64 remainingUs;
+    gc_int64 usedUs;
+    gauX_manager_mix(in_mgr);
+    remainingUs = (gc_int64)in_budgetUs - in_mgr->budgetDebtUs - (gc_int64)(gc_time_ns() - start) / 1000;
+    if(remainingUs > 0)
+      ga_stream_manager_buffer_budget(in_mgr->streamMgr, (gc_uint32)remainingUs);
+    usedUs = (gc_int64)(gc_time_ns() - start) / 1000;
+    /* Carry overruns over (bounded to one budget, so one slow chunk cannot
+       starve the streams for several updates) */
+    in_mgr->budgetDebtUs = usedUs > (gc_int64)in_budgetUs ? usedUs - in_budgetUs : 0;
+    if(in_mgr->budgetDebtUs > (gc_int64)in_budgetUs)
+      in_mgr->budgetDebtUs = in_budgetUs;
+  }
   ga_mixer_dispatch(in_mgr->mixer);
 }
 ga_Mixer* gau_manager_mixer(gau_Manager* in_mgr)
@@ -142,15 +284,28 @@ void gau_manager_destroy(gau_Manager* in_mgr)
 {
   if(in_mgr->threadPolicy == GAU_THREAD_POLICY_MULTI)
   {
+    gc_int32 i;
     in_mgr->killThreads = 1;
-    gc_thread_join(in_mgr->streamThread);
+    ga_stream_manager_wake(in_mgr->streamMgr);
+    for(i = 0; i < in_mgr->numStreamThreads; ++i)
+    {
+      gc_thread_join(in_mgr->streamThreads[i]);
+      gc_thread_destroy(in_mgr->streamThreads[i]);
+    }
+    gcX_ops->freeFunc(in_mgr->streamThreads);
     gc_thread_join(in_mgr->mixThread);
+    gc_thread_destroy(in_mgr->mixThread);
+  }
+  else if(in_mgr->threadPolicy == GAU_THREAD_POLICY_JOBS)
+  {
+    gauX_manager_wait_jobs(in_mgr);
+    gcX_ops->freeFunc(in_mgr->jobs);
   }
 
   /* Clean up mixer and stream manager */
   ga_stream_manager_destroy(in_mgr->streamMgr);
   ga_mixer_destroy(in_mgr->mixer);
-  gcX_ops->freeFunc(in_mgr->mixBuffer);
+  gc_realtime_free(in_mgr->mixBuffer);
   ga_device_close(in_mgr->device);
   gcX_ops->freeFunc(in_mgr);
 }
@@ -163,8 +318,10 @@ void gau_on_finish_destroy(ga_Handle* in_finishedHandle, void* in_context)
 
 /* File-Based Data Source */
 typedef struct gau_DataSourceFileContext {
-  FILE* f;
-  gc_Mutex* fileMutex;
+  gc_File* file;
+  gc_int64 offset; /* Start of the data within the file */
+  gc_int64 size;
+  volatile gc_int64 pos; /* This reader's own cursor; the file has none */
 } gau_DataSourceFileContext;
 
 typedef struct gau_DataSourceFile {
@@ -174,168 +331,1110 @@ typedef struct gau_DataSourceFile {
 
 gc_int32 gauX_data_source_file_read(void* in_context, void* in_dst, gc_int32 in_size, gc_int32 in_count)
 {
+  /* Positional reads on the shared file, so no lock is needed. The range is
+     claimed by advancing pos before reading it, so concurrent readers never
+     get the same bytes. */
   gau_DataSourceFileContext* ctx = (gau_DataSourceFileContext*)in_context;
-  gc_int32 ret;
-  gc_mutex_lock(ctx->fileMutex);
-  ret = (gc_int32)fread(in_dst, in_size, in_count, ctx->f);
-  gc_mutex_unlock(ctx->fileMutex);
-  return ret;
+  gc_int64 pos = gc_atomic_load64(&ctx->pos);
+  gc_int32 toRead;
+  gc_int32 numRead;
+  for(;;)
+  {
+    gc_int64 prev;
+    gc_int64 remaining = ctx->size - pos;
+    toRead = in_size * in_count;
+    toRead = toRead < remaining ? toRead : (gc_int32)remaining;
+    toRead = toRead - (toRead % in_size);
+    if(toRead <= 0)
+      return 0;
+    prev = gc_atomic_cas64(&ctx->pos, pos, pos + toRead);
+    if(prev == pos)
+      break;
+    pos = prev;
+  }
+  numRead = gc_file_read_at(ctx->file, in_dst, toRead, ctx->offset + pos);
+  numRead = numRead > 0 ? numRead - (numRead % in_size) : 0;
+  if(numRead < toRead)
+    gc_atomic_cas64(&ctx->pos, pos + toRead, pos + numRead); /* Give back what wasn't read, unless pos has moved on */
+  return numRead / in_size;
 }
-gc_int32 gauX_data_source_file_seek(void* in_context, gc_int32 in_offset, gc_int32 in_origin)
+gc_int32 gauX_data_source_file_seek(void* in_context, gc_int64 in_offset, gc_int32 in_origin)
 {
   gau_DataSourceFileContext* ctx = (gau_DataSourceFileContext*)in_context;
-  gc_mutex_lock(ctx->fileMutex);
+  gc_int64 pos;
   switch(in_origin)
   {
-  case GA_SEEK_ORIGIN_SET: fseek(ctx->f, in_offset, SEEK_SET); break;
-  case GA_SEEK_ORIGIN_CUR: fseek(ctx->f, in_offset, SEEK_CUR); break;
-  case GA_SEEK_ORIGIN_END: fseek(ctx->f, in_offset, SEEK_END); break;
+  case GA_SEEK_ORIGIN_SET: pos = in_offset; break;
+  case GA_SEEK_ORIGIN_CUR: pos = gc_atomic_load64(&ctx->pos) + in_offset; break;
+  case GA_SEEK_ORIGIN_END: pos = ctx->size + in_offset; break;
+  default: return -1;
   }
-  gc_mutex_unlock(ctx->fileMutex);
+  if(pos < 0 || pos > ctx->size)
+    return -1;
+  gc_atomic_store64(&ctx->pos, pos);
   return 0;
 }
-gc_int32 gauX_data_source_file_tell(void* in_context)
+gc_int64 gauX_data_source_file_tell(void* in_context)
 {
   gau_DataSourceFileContext* ctx = (gau_DataSourceFileContext*)in_context;
-  gc_int32 ret;
-  gc_mutex_lock(ctx->fileMutex);
-  ret = ftell(ctx->f);
-  gc_mutex_unlock(ctx->fileMutex);
-  return ret;
+  return gc_atomic_load64(&ctx->pos);
 }
 void gauX_data_source_file_close(void* in_context)
 {
   gau_DataSourceFileContext* ctx = (gau_DataSourceFileContext*)in_context;
-  fclose(ctx->f);
-  gc_mutex_destroy(ctx->fileMutex);
+  gc_file_release(ctx->file);
 }
-ga_DataSource* gau_data_source_create_file(const char* in_filename)
+ga_DataSource* gau_data_source_create_file_shared(gc_File* in_file, gc_int64 in_offset, gc_int64 in_size)
 {
-  gau_DataSourceFile* ret = gcX_ops->allocFunc(sizeof(gau_DataSourceFile));
+  gau_DataSourceFile* ret;
+  if(in_offset < 0 || in_offset > in_file->size)
+    return 0;
+  if(in_size < 0 || in_size > in_file->size - in_offset)
+    in_size = in_file->size - in_offset; /* To the end of the file */
+  ret = gcX_ops->allocFunc(sizeof(gau_DataSourceFile));
   ga_data_source_init(&ret->dataSrc);
   ret->dataSrc.flags = GA_FLAG_SEEKABLE | GA_FLAG_THREADSAFE;
   ret->dataSrc.readFunc = &gauX_data_source_file_read;
   ret->dataSrc.seekFunc = &gauX_data_source_file_seek;
   ret->dataSrc.tellFunc = &gauX_data_source_file_tell;
   ret->dataSrc.closeFunc = &gauX_data_source_file_close;
-  ret->context.f = fopen(in_filename, "rb");
-  if(ret->context.f)
-    ret->context.fileMutex = gc_mutex_create();
+  gc_file_acquire(in_file);
+  ret->context.file = in_file;
+  ret->context.offset = in_offset;
+  ret->context.size = in_size;
+  ret->context.pos = 0;
+  return (ga_DataSource*)ret;
+}
+ga_DataSource* gau_data_source_create_file(const char* in_filename)
+{
+  return gau_data_source_create_file_arc(in_filename, 0, 0);
+}
+
+/* File-Based Archived Data Source */
+ga_DataSource* gau_data_source_create_file_arc(const char* in_filename, gc_int64 in_offset, gc_int64 in_size)
+{
+  ga_DataSource* ret;
+  gc_File* file;
+  if(in_size < 0)
+    return 0;
+  file = gc_file_open(in_filename);
+  if(!file)
+    return 0;
+  ret = gau_data_source_create_file_shared(file, in_offset, in_size ? in_size : -1);
+  gc_file_release(file); /* The data source holds its own reference */
+  return ret;
+}
+
+/* Block Cache */
+typedef struct gauX_CacheBlock {
+  gc_int32 fileId; /* -1 for an unused block */
+  gc_int32 index; /* Block index within the file */
+  gc_int32 size; /* Valid bytes (fewer than the block size at the end of a file) */
+  char* data;
+  struct gauX_CacheBlock* hashNext;
+  struct gauX_CacheBlock* lruPrev; /* Towards the most recently used */
+  struct gauX_CacheBlock* lruNext; /* Towards the least recently used */
+} gauX_CacheBlock;
+
+struct gau_BlockCache {
+  gc_int32 blockSize;
+  gc_int32 numBlocks;
+  gc_int32 readAheadBlocks;
+  gauX_CacheBlock* blocks;
+  char* blockData;
+  gauX_CacheBlock** hashTable;
+  gc_uint32 hashSize; /* Power of two, at least the block count */
+  gauX_CacheBlock* lruHead; /* Most recently used */
+  gauX_CacheBlock* lruTail; /* Least recently used; evicted first */
+  char** filenames; /* Interned file names; a file's id is its index */
+  gc_int32 numFiles;
+  char* scratch; /* Read-ahead buffer, shared by the cache's data sources (0 without read-ahead) */
+  gc_int32 scratchBusy; /* Whether a read-ahead is using 'scratch' */
+  gau_BlockCacheStats stats;
+  gc_Mutex* cacheMutex;
+};
+
+static gc_uint32 gauX_block_cache_hash(gau_BlockCache* in_cache, gc_int32 in_fileId, gc_int32 in_index)
+{
+  return ((gc_uint32)in_fileId * 2654435761u + (gc_uint32)in_index) & (in_cache->hashSize - 1);
+}
+static void gauX_block_cache_unlink(gau_BlockCache* in_cache, gauX_CacheBlock* in_block)
+{
+  if(in_block->lruPrev)
+    in_block->lruPrev->lruNext = in_block->lruNext;
   else
+    in_cache->lruHead = in_block->lruNext;
+  if(in_block->lruNext)
+    in_block->lruNext->lruPrev = in_block->lruPrev;
+  else
+    in_cache->lruTail = in_block->lruPrev;
+}
+static void gauX_block_cache_touch(gau_BlockCache* in_cache, gauX_CacheBlock* in_block)
+{
+  gauX_block_cache_unlink(in_cache, in_block);
+  in_block->lruPrev = 0;
+  in_block->lruNext = in_cache->lruHead;
+  if(in_cache->lruHead)
+    in_cache->lruHead->lruPrev = in_block;
+  else
+    in_cache->lruTail = in_block;
+  in_cache->lruHead = in_block;
+}
+static gauX_CacheBlock* gauX_block_cache_find(gau_BlockCache* in_cache, gc_int32 in_fileId, gc_int32 in_index)
+{
+  gauX_CacheBlock* block = in_cache->hashTable[gauX_block_cache_hash(in_cache, in_fileId, in_index)];
+  while(block && (block->fileId != in_fileId || block->index != in_index))
+    block = block->hashNext;
+  return block;
+}
+static void gauX_block_cache_insert(gau_BlockCache* in_cache, gc_int32 in_fileId, gc_int32 in_index,
+                                    const char* in_data, gc_int32 in_size)
+{
+  gauX_CacheBlock* block = gauX_block_cache_find(in_cache, in_fileId, in_index);
+  gauX_CacheBlock** link;
+  if(!block)
   {
-    gcX_ops->freeFunc(ret);
-    ret = 0;
+    /* Recycle the least recently used block */
+    block = in_cache->lruTail;
+    if(block->fileId >= 0)
+    {
+      link = &in_cache->hashTable[gauX_block_cache_hash(in_cache, block->fileId, block->index)];
+      while(*link != block)
+        link = &(*link)->hashNext;
+      *link = block->hashNext;
+      ++in_cache->stats.evictions;
+    }
+    block->fileId = in_fileId;
+    block->index = in_index;
+    link = &in_cache->hashTable[gauX_block_cache_hash(in_cache, in_fileId, in_index)];
+    block->hashNext = *link;
+    *link = block;
   }
-  return (ga_DataSource*)ret;
+  memcpy(block->data, in_data, in_size);
+  block->size = in_size;
+  gauX_block_cache_touch(in_cache, block);
+}
+static gc_int32 gauX_block_cache_file_id(gau_BlockCache* in_cache, const char* in_filename)
+{
+  gc_int32 i;
+  gc_int32 length = (gc_int32)strlen(in_filename);
+  gc_mutex_lock(in_cache->cacheMutex);
+  for(i = 0; i < in_cache->numFiles; ++i)
+  {
+    if(strcmp(in_cache->filenames[i], in_filename) == 0)
+      break;
+  }
+  if(i == in_cache->numFiles)
+  {
+    in_cache->filenames = gcX_ops->reallocFunc(in_cache->filenames, (i + 1) * sizeof(char*));
+    in_cache->filenames[i] = gcX_ops->allocFunc(length + 1);
+    memcpy(in_cache->filenames[i], in_filename, length + 1);
+    ++in_cache->numFiles;
+  }
+  gc_mutex_unlock(in_cache->cacheMutex);
+  return i;
+}
+gau_BlockCache* gau_block_cache_create(gc_int32 in_blockSize, gc_int32 in_budget,
+                                       gc_int32 in_readAheadBlocks)
+{
+  gau_BlockCache* ret = gcX_ops->allocFunc(sizeof(gau_BlockCache));
+  gc_int32 i;
+  ret->blockSize = in_blockSize;
+  ret->numBlocks = in_budget / in_blockSize;
+  if(ret->numBlocks < 1)
+    ret->numBlocks = 1;
+  ret->readAheadBlocks = in_readAheadBlocks < 0 ? 0 : in_readAheadBlocks;
+  ret->blocks = gcX_ops->allocFunc(ret->numBlocks * sizeof(gauX_CacheBlock));
+  ret->blockData = gcX_ops->allocFunc(ret->numBlocks * in_blockSize);
+  ret->hashSize = 1;
+  while(ret->hashSize < (gc_uint32)ret->numBlocks)
+    ret->hashSize <<= 1;
+  ret->hashTable = gcX_ops->allocFunc(ret->hashSize * sizeof(gauX_CacheBlock*));
+  memset(ret->hashTable, 0, ret->hashSize * sizeof(gauX_CacheBlock*));
+  for(i = 0; i < ret->numBlocks; ++i)
+  {
+    gauX_CacheBlock* block = &ret->blocks[i];
+    block->fileId = -1;
+    block->index = 0;
+    block->size = 0;
+    block->data = ret->blockData + i * in_blockSize;
+    block->hashNext = 0;
+    block->lruPrev = i > 0 ? &ret->blocks[i - 1] : 0;
+    block->lruNext = i < ret->numBlocks - 1 ? &ret->blocks[i + 1] : 0;
+  }
+  ret->lruHead = &ret->blocks[0];
+  ret->lruTail = &ret->blocks[ret->numBlocks - 1];
+  ret->filenames = 0;
+  ret->numFiles = 0;
+  /* The longest read-ahead covers the missed block and the blocks after it */
+  i = ret->readAheadBlocks < ret->numBlocks ? ret->readAheadBlocks + 1 : ret->numBlocks;
+  ret->scratch = i > 1 ? gcX_ops->allocFunc(i * in_blockSize) : 0;
+  ret->scratchBusy = 0;
+  memset(&ret->stats, 0, sizeof(gau_BlockCacheStats));
+  ret->cacheMutex = gc_mutex_create_named("gau_BlockCache::cacheMutex");
+  return ret;
+}
+void gau_block_cache_stats(gau_BlockCache* in_cache, gau_BlockCacheStats* out_stats)
+{
+  gc_mutex_lock(in_cache->cacheMutex);
+  memcpy(out_stats, &in_cache->stats, sizeof(gau_BlockCacheStats));
+  gc_mutex_unlock(in_cache->cacheMutex);
+}
+void gau_block_cache_reset_stats(gau_BlockCache* in_cache)
+{
+  gc_mutex_lock(in_cache->cacheMutex);
+  memset(&in_cache->stats, 0, sizeof(gau_BlockCacheStats));
+  gc_mutex_unlock(in_cache->cacheMutex);
+}
+void gau_block_cache_destroy(gau_BlockCache* in_cache)
+{
+  gc_int32 i;
+  for(i = 0; i < in_cache->numFiles; ++i)
+    gcX_ops->freeFunc(in_cache->filenames[i]);
+  if(in_cache->filenames)
+    gcX_ops->freeFunc(in_cache->filenames);
+  gc_mutex_destroy(in_cache->cacheMutex);
+  if(in_cache->scratch)
+    gcX_ops->freeFunc(in_cache->scratch);
+  gcX_ops->freeFunc(in_cache->hashTable);
+  gcX_ops->freeFunc(in_cache->blockData);
+  gcX_ops->freeFunc(in_cache->blocks);
+  gcX_ops->freeFunc(in_cache);
 }
 
-/* File-Based Archived Data Source */
-typedef struct gau_DataSourceFileArcContext {
-  gc_int32 offset;
-  gc_int32 size;
-  FILE* f;
-  gc_Mutex* fileMutex;
-} gau_DataSourceFileArcContext;
+/* Cached File-Based Data Source */
+typedef struct gau_DataSourceCachedContext {
+  gau_BlockCache* cache;
+  gc_File* file;
+  gc_int32 fileId;
+  gc_int64 pos;
+  gc_int32 blockIndex; /* Index of the block copied into 'block', or -1 */
+  gc_int32 blockValid; /* Valid bytes in 'block' */
+  char* block;
+  gc_Mutex* posMutex;
+} gau_DataSourceCachedContext;
 
-typedef struct gau_DataSourceFileArc {
+typedef struct gau_DataSourceCached {
   ga_DataSource dataSrc;
-  gau_DataSourceFileArcContext context;
-} gau_DataSourceFileArc;
+  gau_DataSourceCachedContext context;
+} gau_DataSourceCached;
 
-gc_int32 gauX_data_source_file_arc_read(void* in_context, void* in_dst, gc_int32 in_size, gc_int32 in_count)
+static gc_int32 gauX_data_source_cached_fetch(gau_DataSourceCachedContext* in_ctx, gc_int32 in_index)
+{
+  gau_BlockCache* cache = in_ctx->cache;
+  gc_int32 blockSize = cache->blockSize;
+  gc_int32 numFileBlocks = (gc_int32)((in_ctx->file->size + blockSize - 1) / blockSize);
+  gc_int32 sequential = in_index == in_ctx->blockIndex + 1;
+  gauX_CacheBlock* block;
+  gc_int32 numBlocks = 1;
+  gc_int64 offset = (gc_int64)in_index * blockSize;
+  gc_int64 numBytes;
+  gc_int32 numRead;
+  char* data;
+  gc_int32 i;
+
+  gc_mutex_lock(cache->cacheMutex);
+  block = gauX_block_cache_find(cache, in_ctx->fileId, in_index);
+  if(block)
+  {
+    gauX_block_cache_touch(cache, block);
+    memcpy(in_ctx->block, block->data, block->size);
+    in_ctx->blockValid = block->size;
+    in_ctx->blockIndex = in_index;
+    ++cache->stats.hits;
+    gc_mutex_unlock(cache->cacheMutex);
+    return 1;
+  }
+  ++cache->stats.misses;
+  if(sequential && cache->scratch && !cache->scratchBusy)
+  {
+    /* Extend the read over the following uncached blocks. If another
+       read-ahead holds the scratch buffer, only the missed block is read. */
+    while(numBlocks <= cache->readAheadBlocks && numBlocks < cache->numBlocks &&
+          in_index + numBlocks < numFileBlocks &&
+          !gauX_block_cache_find(cache, in_ctx->fileId, in_index + numBlocks))
+      ++numBlocks;
+    cache->scratchBusy = numBlocks > 1;
+  }
+  gc_mutex_unlock(cache->cacheMutex);
+
+  /* Read from the file without holding the cache lock */
+  numBytes = in_ctx->file->size - offset;
+  numBytes = numBytes < numBlocks * blockSize ? numBytes : numBlocks * blockSize;
+  data = numBlocks > 1 ? cache->scratch : in_ctx->block;
+  numRead = gc_file_read_at(in_ctx->file, data, (gc_int32)numBytes, offset);
+  gc_mutex_lock(cache->cacheMutex);
+  if(numRead > 0)
+  {
+    cache->stats.bytesRead += numRead;
+    for(i = 0; i * blockSize < numRead; ++i)
+    {
+      gc_int32 size = numRead - i * blockSize;
+      size = size < blockSize ? size : blockSize;
+      gauX_block_cache_insert(cache, in_ctx->fileId, in_index + i, data + i * blockSize, size);
+      if(i > 0)
+        ++cache->stats.readAheads;
+    }
+    if(data != in_ctx->block)
+      memcpy(in_ctx->block, data, numRead < blockSize ? numRead : blockSize);
+  }
+  if(data != in_ctx->block)
+    cache->scratchBusy = 0;
+  gc_mutex_unlock(cache->cacheMutex);
+  if(numRead > 0)
+  {
+    in_ctx->blockValid = numRead < blockSize ? numRead : blockSize;
+    in_ctx->blockIndex = in_index;
+  }
+  else
+    in_ctx->blockIndex = -1;
+  return numRead > 0;
+}
+gc_int32 gauX_data_source_cached_read(void* in_context, void* in_dst, gc_int32 in_size, gc_int32 in_count)
 {
-  gau_DataSourceFileArcContext* ctx = (gau_DataSourceFileArcContext*)in_context;
-  gc_int32 ret;
-  /* TODO: Implement in-archive EOF detection? */
-  gc_mutex_lock(ctx->fileMutex);
-  ret = (gc_int32)fread(in_dst, in_size, in_count, ctx->f);
-  gc_mutex_unlock(ctx->fileMutex);
-  return ret;
+  gau_DataSourceCachedContext* ctx = (gau_DataSourceCachedContext*)in_context;
+  gc_int32 blockSize = ctx->cache->blockSize;
+  gc_int32 toRead = in_size * in_count;
+  gc_int32 numRead = 0;
+  gc_int64 remaining;
+  gc_mutex_lock(ctx->posMutex);
+  remaining = ctx->file->size - ctx->pos;
+  toRead = toRead < remaining ? toRead : (gc_int32)remaining;
+  toRead = toRead - (toRead % in_size);
+  while(numRead < toRead)
+  {
+    gc_int32 index = (gc_int32)(ctx->pos / blockSize);
+    gc_int32 blockOffset = (gc_int32)(ctx->pos % blockSize);
+    gc_int32 bytes;
+    if(index != ctx->blockIndex && !gauX_data_source_cached_fetch(ctx, index))
+      break;
+    bytes = ctx->blockValid - blockOffset;
+    if(bytes <= 0)
+      break;
+    bytes = bytes < toRead - numRead ? bytes : toRead - numRead;
+    memcpy((char*)in_dst + numRead, ctx->block + blockOffset, bytes);
+    numRead += bytes;
+    ctx->pos += bytes;
+  }
+  gc_mutex_unlock(ctx->posMutex);
+  return numRead / in_size;
 }
-gc_int32 gauX_data_source_file_arc_seek(void* in_context, gc_int32 in_offset, gc_int32 in_origin)
+gc_int32 gauX_data_source_cached_borrow(void* in_context, gc_int32 in_maxBytes, const void** out_data)
 {
-  /* TODO: What is the best way to resolve the seeking-OOB cases? */
-  gau_DataSourceFileArcContext* ctx = (gau_DataSourceFileArcContext*)in_context;
-  gc_mutex_lock(ctx->fileMutex);
+  gau_DataSourceCachedContext* ctx = (gau_DataSourceCachedContext*)in_context;
+  gc_int32 index;
+  gc_int32 blockOffset;
+  gc_int32 bytes = 0;
+  gc_mutex_lock(ctx->posMutex);
+  index = (gc_int32)(ctx->pos / ctx->cache->blockSize);
+  blockOffset = (gc_int32)(ctx->pos % ctx->cache->blockSize);
+  if(ctx->pos < ctx->file->size &&
+     (index == ctx->blockIndex || gauX_data_source_cached_fetch(ctx, index)))
+  {
+    bytes = ctx->blockValid - blockOffset;
+    bytes = bytes < in_maxBytes ? bytes : in_maxBytes;
+    bytes = bytes > 0 ? bytes : 0;
+    *out_data = ctx->block + blockOffset;
+    ctx->pos += bytes;
+  }
+  gc_mutex_unlock(ctx->posMutex);
+  return bytes;
+}
+gc_int32 gauX_data_source_cached_seek(void* in_context, gc_int64 in_offset, gc_int32 in_origin)
+{
+  /* The local block stays valid; it is keyed by block index, not position */
+  gau_DataSourceCachedContext* ctx = (gau_DataSourceCachedContext*)in_context;
+  gc_int64 pos;
+  gc_int32 ret = 0;
+  gc_mutex_lock(ctx->posMutex);
   switch(in_origin)
   {
-  case GA_SEEK_ORIGIN_SET:
-    if(ctx->size > 0 && in_offset > ctx->size)
+  case GA_SEEK_ORIGIN_SET: pos = in_offset; break;
+  case GA_SEEK_ORIGIN_CUR: pos = ctx->pos + in_offset; break;
+  case GA_SEEK_ORIGIN_END: pos = ctx->file->size + in_offset; break;
+  default: pos = -1; break;
+  }
+  if(pos < 0 || pos > ctx->file->size)
+    ret = -1;
+  else
+    ctx->pos = pos;
+  gc_mutex_unlock(ctx->posMutex);
+  return ret;
+}
+gc_int64 gauX_data_source_cached_tell(void* in_context)
+{
+  gau_DataSourceCachedContext* ctx = (gau_DataSourceCachedContext*)in_context;
+  gc_int64 ret;
+  gc_mutex_lock(ctx->posMutex);
+  ret = ctx->pos;
+  gc_mutex_unlock(ctx->posMutex);
+  return ret;
+}
+void gauX_data_source_cached_close(void* in_context)
+{
+  gau_DataSourceCachedContext* ctx = (gau_DataSourceCachedContext*)in_context;
+  gc_file_release(ctx->file);
+  gcX_ops->freeFunc(ctx->block);
+  gc_mutex_destroy(ctx->posMutex);
+}
+ga_DataSource* gau_data_source_create_file_cached(gau_BlockCache* in_cache, const char* in_filename)
+{
+  gau_DataSourceCached* ret;
+  gc_File* file = gc_file_open(in_filename);
+  if(!file)
+    return 0;
+  ret = gcX_ops->allocFunc(sizeof(gau_DataSourceCached));
+  ga_data_source_init(&ret->dataSrc);
+  ret->dataSrc.flags = GA_FLAG_SEEKABLE | GA_FLAG_THREADSAFE;
+  ret->dataSrc.readFunc = &gauX_data_source_cached_read;
+  ret->dataSrc.seekFunc = &gauX_data_source_cached_seek;
+  ret->dataSrc.tellFunc = &gauX_data_source_cached_tell;
+  ret->dataSrc.borrowFunc = &gauX_data_source_cached_borrow;
+  ret->dataSrc.closeFunc = &gauX_data_source_cached_close;
+  ret->context.cache = in_cache;
+  ret->context.file = file;
+  ret->context.fileId = gauX_block_cache_file_id(in_cache, in_filename);
+  ret->context.pos = 0;
+  ret->context.blockIndex = -1;
+  ret->context.blockValid = 0;
+  ret->context.block = gcX_ops->allocFunc(in_cache->blockSize);
+  ret->context.posMutex = gc_mutex_create_named("gau_DataSourceCached::posMutex");
+  return (ga_DataSource*)ret;
+}
+
+/* I/O Thread Pool */
+typedef struct gau_DataSourceReadAheadContext gau_DataSourceReadAheadContext;
+
+struct gau_IoPool {
+  gc_Thread** threads;
+  gc_int32 numThreads;
+  gau_DataSourceReadAheadContext* head; /* Pending fills, oldest first */
+  gau_DataSourceReadAheadContext* tail;
+  gc_Mutex* queueMutex;
+  gc_Event* wakeEvent;
+  volatile gc_int32 killThreads;
+};
+
+/* Read-Ahead Data Source */
+struct gau_DataSourceReadAheadContext {
+  gau_IoPool* pool;
+  ga_DataSource* dataSrc;
+  gc_int32 bufferSize;
+  char* buffers[2];
+  gc_int32 front; /* Index of the buffer being consumed */
+  gc_int64 frontStart; /* Source position of the front buffer's first byte */
+  gc_int32 frontValid; /* Valid bytes in the front buffer */
+  gc_int32 frontPos; /* Read position within the front buffer */
+  gc_int32 backValid; /* Valid bytes in the back buffer (written by the pool) */
+  gc_int32 pending; /* A fill of the back buffer has been queued */
+  gc_int32 end; /* The last fill returned nothing: the end of the source */
+  volatile gc_int32 filled; /* Set by the pool when the queued fill completes */
+  gc_Event* filledEvent;
+  gc_Mutex* filledMutex; /* Held by the pool while it signals completion */
+  gc_Mutex* readMutex;
+  gau_DataSourceReadAheadContext* ioNext;
+};
+
+typedef struct gau_DataSourceReadAhead {
+  ga_DataSource dataSrc;
+  gau_DataSourceReadAheadContext context;
+} gau_DataSourceReadAhead;
+
+static gc_int32 gauX_ioThreadFunc(void* in_context)
+{
+  gau_IoPool* pool = (gau_IoPool*)in_context;
+  while(!gc_atomic_load(&pool->killThreads))
+  {
+    gau_DataSourceReadAheadContext* ctx;
+    gc_mutex_lock(pool->queueMutex);
+    ctx = pool->head;
+    if(ctx)
     {
-      gc_mutex_unlock(ctx->fileMutex);
-      return -1;
+      pool->head = ctx->ioNext;
+      if(!pool->head)
+        pool->tail = 0;
     }
-    fseek(ctx->f, ctx->offset + in_offset, SEEK_SET);
-    break;
-  case GA_SEEK_ORIGIN_CUR:
+    gc_mutex_unlock(pool->queueMutex);
+    if(!ctx)
     {
-      gc_int32 curPos = ftell(ctx->f) - ctx->offset;
-      gc_int32 newPos = curPos + in_offset;
-      if(newPos < 0 || (ctx->size > 0 && newPos > ctx->size))
-      {
-        gc_mutex_unlock(ctx->fileMutex);
-        return -1;
-      }
-      fseek(ctx->f, in_offset, SEEK_CUR);
+      gc_event_wait(pool->wakeEvent, 50);
+      continue;
+    }
+    ctx->backValid = ga_data_source_read(ctx->dataSrc, ctx->buffers[ctx->front ^ 1], 1, ctx->bufferSize);
+    gc_mutex_lock(ctx->filledMutex);
+    gc_atomic_store(&ctx->filled, 1);
+    gc_event_signal(ctx->filledEvent);
+    gc_mutex_unlock(ctx->filledMutex); /* Last touch; the reader may close now */
+  }
+  gc_event_signal(pool->wakeEvent); /* Pass the shutdown on to the other threads */
+  return 0;
+}
+gau_IoPool* gau_io_pool_create(gc_int32 in_numThreads)
+{
+  gau_IoPool* ret = gcX_ops->allocFunc(sizeof(gau_IoPool));
+  gc_int32 i;
+  ret->numThreads = in_numThreads < 1 ? 1 : in_numThreads;
+  ret->head = 0;
+  ret->tail = 0;
+  ret->queueMutex = gc_mutex_create_named("gau_IoPool::queueMutex");
+  ret->wakeEvent = gc_event_create();
+  ret->killThreads = 0;
+  ret->threads = gcX_ops->allocFunc(ret->numThreads * sizeof(gc_Thread*));
+  for(i = 0; i < ret->numThreads; ++i)
+  {
+    ret->threads[i] = gc_thread_create(gauX_ioThreadFunc, ret, GC_THREAD_PRIORITY_HIGH, 64 * 1024);
+    gc_thread_run(ret->threads[i]);
+  }
+  return ret;
+}
+void gau_io_pool_destroy(gau_IoPool* in_pool)
+{
+  gc_int32 i;
+  gc_atomic_store(&in_pool->killThreads, 1);
+  gc_event_signal(in_pool->wakeEvent);
+  for(i = 0; i < in_pool->numThreads; ++i)
+  {
+    gc_thread_join(in_pool->threads[i]);
+    gc_thread_destroy(in_pool->threads[i]);
+  }
+  gcX_ops->freeFunc(in_pool->threads);
+  gc_event_destroy(in_pool->wakeEvent);
+  gc_mutex_destroy(in_pool->queueMutex);
+  gcX_ops->freeFunc(in_pool);
+}
+static void gauX_data_source_read_ahead_queue(gau_DataSourceReadAheadContext* in_ctx)
+{
+  gau_IoPool* pool = in_ctx->pool;
+  in_ctx->pending = 1;
+  in_ctx->ioNext = 0;
+  gc_mutex_lock(pool->queueMutex);
+  if(pool->tail)
+    pool->tail->ioNext = in_ctx;
+  else
+    pool->head = in_ctx;
+  pool->tail = in_ctx;
+  gc_mutex_unlock(pool->queueMutex);
+  gc_event_signal(pool->wakeEvent);
+}
+static void gauX_data_source_read_ahead_collect(gau_DataSourceReadAheadContext* in_ctx)
+{
+  while(!gc_atomic_load(&in_ctx->filled))
+    gc_event_wait(in_ctx->filledEvent, 50);
+  gc_mutex_lock(in_ctx->filledMutex); /* Wait for the pool to finish signaling */
+  in_ctx->filled = 0;
+  gc_mutex_unlock(in_ctx->filledMutex);
+  in_ctx->pending = 0;
+}
+static gc_int32 gauX_data_source_read_ahead_swap(gau_DataSourceReadAheadContext* in_ctx)
+{
+  /* Swap in the back buffer, then start filling the other one */
+  if(!in_ctx->pending)
+    return 0; /* End of source */
+  gauX_data_source_read_ahead_collect(in_ctx);
+  in_ctx->frontStart += in_ctx->frontValid;
+  in_ctx->front ^= 1;
+  in_ctx->frontValid = in_ctx->backValid > 0 ? in_ctx->backValid : 0;
+  in_ctx->frontPos = 0;
+  in_ctx->end = in_ctx->backValid <= 0; /* A short fill isn't the end; sources may return less than asked */
+  if(!in_ctx->end)
+    gauX_data_source_read_ahead_queue(in_ctx);
+  return 1;
+}
+gc_int32 gauX_data_source_read_ahead_read(void* in_context, void* in_dst, gc_int32 in_size, gc_int32 in_count)
+{
+  gau_DataSourceReadAheadContext* ctx = (gau_DataSourceReadAheadContext*)in_context;
+  gc_int32 toRead = in_size * in_count;
+  gc_int32 numRead = 0;
+  gc_mutex_lock(ctx->readMutex);
+  while(numRead < toRead)
+  {
+    gc_int32 bytes = ctx->frontValid - ctx->frontPos;
+    if(bytes <= 0)
+    {
+      if(!gauX_data_source_read_ahead_swap(ctx))
+        break;
+      continue;
     }
-    break;
-  case GA_SEEK_ORIGIN_END:
-    if(ctx->size <= 0)
+    bytes = bytes < toRead - numRead ? bytes : toRead - numRead;
+    memcpy((char*)in_dst + numRead, ctx->buffers[ctx->front] + ctx->frontPos, bytes);
+    numRead += bytes;
+    ctx->frontPos += bytes;
+  }
+  gc_mutex_unlock(ctx->readMutex);
+  return numRead / in_size;
+}
+gc_int32 gauX_data_source_read_ahead_borrow(void* in_context, gc_int32 in_maxBytes, const void** out_data)
+{
+  gau_DataSourceReadAheadContext* ctx = (gau_DataSourceReadAheadContext*)in_context;
+  gc_int32 bytes = 0;
+  gc_mutex_lock(ctx->readMutex);
+  while(ctx->frontPos == ctx->frontValid && gauX_data_source_read_ahead_swap(ctx));
+  bytes = ctx->frontValid - ctx->frontPos;
+  bytes = bytes < in_maxBytes ? bytes : in_maxBytes;
+  *out_data = ctx->buffers[ctx->front] + ctx->frontPos;
+  ctx->frontPos += bytes;
+  gc_mutex_unlock(ctx->readMutex);
+  return bytes;
+}
+gc_int32 gauX_data_source_read_ahead_seek(void* in_context, gc_int64 in_offset, gc_int32 in_origin)
+{
+  gau_DataSourceReadAheadContext* ctx = (gau_DataSourceReadAheadContext*)in_context;
+  gc_int32 wasPending;
+  gc_int64 innerPos;
+  gc_mutex_lock(ctx->readMutex);
+  if(in_origin == GA_SEEK_ORIGIN_CUR)
+  {
+    in_offset += ctx->frontStart + ctx->frontPos;
+    in_origin = GA_SEEK_ORIGIN_SET;
+  }
+  if(in_origin == GA_SEEK_ORIGIN_SET && in_offset >= ctx->frontStart &&
+     in_offset <= ctx->frontStart + ctx->frontValid)
+  {
+    /* Within the front buffer */
+    ctx->frontPos = (gc_int32)(in_offset - ctx->frontStart);
+    gc_mutex_unlock(ctx->readMutex);
+    return 0;
+  }
+  wasPending = ctx->pending;
+  if(wasPending)
+    gauX_data_source_read_ahead_collect(ctx);
+  innerPos = ctx->frontStart + ctx->frontValid + (wasPending && ctx->backValid > 0 ? ctx->backValid : 0);
+  if(ga_data_source_seek64(ctx->dataSrc, in_offset, in_origin) < 0)
+  {
+    /* Keep both buffers, so reading carries on from the same position: put
+       the source back where the fill left it, and hand the fill back */
+    if(ga_data_source_tell64(ctx->dataSrc) != innerPos)
+      ga_data_source_seek64(ctx->dataSrc, innerPos, GA_SEEK_ORIGIN_SET);
+    if(wasPending)
     {
-      gc_mutex_unlock(ctx->fileMutex);
-      return -1;
+      ctx->pending = 1;
+      gc_atomic_store(&ctx->filled, 1);
     }
-    fseek(ctx->f, ctx->offset + ctx->size + in_offset, SEEK_SET);
-    break;
+    gc_mutex_unlock(ctx->readMutex);
+    return -1;
   }
-  gc_mutex_unlock(ctx->fileMutex);
+  ctx->frontStart = ga_data_source_tell64(ctx->dataSrc);
+  ctx->frontValid = 0;
+  ctx->frontPos = 0;
+  ctx->end = 0;
+  gauX_data_source_read_ahead_queue(ctx);
+  gc_mutex_unlock(ctx->readMutex);
   return 0;
 }
-gc_int32 gauX_data_source_file_arc_tell(void* in_context)
+gc_int64 gauX_data_source_read_ahead_tell(void* in_context)
 {
-  gau_DataSourceFileArcContext* ctx = (gau_DataSourceFileArcContext*)in_context;
-  gc_int32 ret;
-  gc_mutex_lock(ctx->fileMutex);
-  ret = ftell(ctx->f) - ctx->offset;
-  gc_mutex_unlock(ctx->fileMutex);
+  gau_DataSourceReadAheadContext* ctx = (gau_DataSourceReadAheadContext*)in_context;
+  gc_int64 ret;
+  gc_mutex_lock(ctx->readMutex);
+  ret = ctx->frontStart + ctx->frontPos;
+  gc_mutex_unlock(ctx->readMutex);
   return ret;
 }
-void gauX_data_source_file_arc_close(void* in_context)
+void gauX_data_source_read_ahead_close(void* in_context)
 {
-  gau_DataSourceFileArcContext* ctx = (gau_DataSourceFileArcContext*)in_context;
-  fclose(ctx->f);
-  gc_mutex_destroy(ctx->fileMutex);
+  gau_DataSourceReadAheadContext* ctx = (gau_DataSourceReadAheadContext*)in_context;
+  if(ctx->pending)
+    gauX_data_source_read_ahead_collect(ctx);
+  ga_data_source_release(ctx->dataSrc);
+  gcX_ops->freeFunc(ctx->buffers[0]);
+  gcX_ops->freeFunc(ctx->buffers[1]);
+  gc_event_destroy(ctx->filledEvent);
+  gc_mutex_destroy(ctx->filledMutex);
+  gc_mutex_destroy(ctx->readMutex);
 }
-ga_DataSource* gau_data_source_create_file_arc(const char* in_filename, gc_int32 in_offset, gc_int32 in_size)
+ga_DataSource* gau_data_source_create_read_ahead(gau_IoPool* in_pool, ga_DataSource* in_dataSrc,
+                                                 gc_int32 in_bufferSize)
 {
-  gau_DataSourceFileArc* ret = gcX_ops->allocFunc(sizeof(gau_DataSourceFileArc));
+  gau_DataSourceReadAhead* ret = gcX_ops->allocFunc(sizeof(gau_DataSourceReadAhead));
+  gau_DataSourceReadAheadContext* ctx = &ret->context;
   ga_data_source_init(&ret->dataSrc);
-  ret->dataSrc.flags = GA_FLAG_SEEKABLE | GA_FLAG_THREADSAFE;
-  ret->dataSrc.readFunc = &gauX_data_source_file_arc_read;
-  ret->dataSrc.seekFunc = &gauX_data_source_file_arc_seek;
-  ret->dataSrc.tellFunc = &gauX_data_source_file_arc_tell;
-  ret->dataSrc.closeFunc = &gauX_data_source_file_arc_close;
-  ret->context.offset = in_offset;
-  ret->context.size = in_size;
-  ret->context.f = fopen(in_filename, "rb");
-  if(ret->context.f && in_size >= 0)
+  ret->dataSrc.flags = (ga_data_source_flags(in_dataSrc) & GA_FLAG_SEEKABLE) | GA_FLAG_THREADSAFE;
+  ret->dataSrc.readFunc = &gauX_data_source_read_ahead_read;
+  ret->dataSrc.seekFunc = &gauX_data_source_read_ahead_seek;
+  ret->dataSrc.tellFunc = &gauX_data_source_read_ahead_tell;
+  ret->dataSrc.borrowFunc = &gauX_data_source_read_ahead_borrow;
+  ret->dataSrc.closeFunc = &gauX_data_source_read_ahead_close;
+  ga_data_source_acquire(in_dataSrc);
+  ctx->pool = in_pool;
+  ctx->dataSrc = in_dataSrc;
+  ctx->bufferSize = in_bufferSize;
+  ctx->buffers[0] = gcX_ops->allocFunc(in_bufferSize);
+  ctx->buffers[1] = gcX_ops->allocFunc(in_bufferSize);
+  ctx->front = 0;
+  ctx->frontStart = ga_data_source_tell64(in_dataSrc);
+  ctx->frontValid = 0;
+  ctx->frontPos = 0;
+  ctx->backValid = 0;
+  ctx->end = 0;
+  ctx->filled = 0;
+  ctx->filledEvent = gc_event_create();
+  ctx->filledMutex = gc_mutex_create_named("gau_DataSourceReadAhead::filledMutex");
+  ctx->readMutex = gc_mutex_create_named("gau_DataSourceReadAhead::readMutex");
+  gauX_data_source_read_ahead_queue(ctx);
+  return (ga_DataSource*)ret;
+}
+
+/* Archive */
+#define GAUX_ARCHIVE_HEADER_SIZE 16 /* Version 2 headers are 4 bytes longer */
+
+typedef struct gauX_ArchiveEntry {
+  const char* name; /* 0 for an empty slot */
+  gc_int32 nameLength;
+  gc_uint32 hash;
+  gc_int64 offset;
+  gc_int64 size;
+} gauX_ArchiveEntry;
+
+struct gau_Archive {
+  gc_File* file;
+  gauX_ArchiveEntry* table; /* Open-addressed hash index */
+  gc_uint32 tableSize; /* Power of two, at least twice the entry count */
+  gc_int32 numEntries;
+  char* directory; /* Raw directory table; entry names point into it */
+};
+
+static gc_uint32 gauX_archive_hash(const char* in_name, gc_int32 in_length)
+{
+  /* FNV-1a */
+  gc_uint32 hash = 2166136261u;
+  gc_int32 i;
+  for(i = 0; i < in_length; ++i)
   {
-    ret->context.fileMutex = gc_mutex_create();
-    fseek(ret->context.f, in_offset, SEEK_SET);
+    hash ^= (gc_uint8)in_name[i];
+    hash *= 16777619u;
   }
-  else
+  return hash;
+}
+static gc_uint32 gauX_archive_read32(const char* in_data)
+{
+  const gc_uint8* d = (const gc_uint8*)in_data;
+  return d[0] | (d[1] << 8) | (d[2] << 16) | ((gc_uint32)d[3] << 24);
+}
+static gc_int64 gauX_archive_read64(const char* in_data)
+{
+  gc_uint64 hi = gauX_archive_read32(in_data + 4);
+  return (gc_int64)((hi << 32) | gauX_archive_read32(in_data));
+}
+gau_Archive* gau_archive_open(const char* in_filename)
+{
+  gau_Archive* ret;
+  gc_File* file;
+  char header[GAUX_ARCHIVE_HEADER_SIZE + 4];
+  gc_int32 version, headerSize, fieldSize, entrySize;
+  gc_int32 numEntries, dirSize;
+  gc_int64 dirOffset;
+  gc_int32 pos = 0;
+  gc_int32 i;
+  file = gc_file_open(in_filename);
+  if(!file)
+    return 0;
+  if(gc_file_read_at(file, header, GAUX_ARCHIVE_HEADER_SIZE, 0) != GAUX_ARCHIVE_HEADER_SIZE ||
+     memcmp(header, "GPAK", 4) != 0)
   {
-    gcX_ops->freeFunc(ret);
-    ret = 0;
+    gc_file_release(file);
+    return 0;
   }
-  return (ga_DataSource*)ret;
+  /* Version 2 widens the directory offset and the entry offsets and sizes to 64 bits */
+  version = (gc_int32)gauX_archive_read32(header + 4);
+  fieldSize = version == 2 ? 8 : 4;
+  headerSize = GAUX_ARCHIVE_HEADER_SIZE + fieldSize - 4;
+  entrySize = fieldSize * 2 + 2;
+  if((version != 1 && version != 2) ||
+     (version == 2 && gc_file_read_at(file, header + GAUX_ARCHIVE_HEADER_SIZE, 4, GAUX_ARCHIVE_HEADER_SIZE) != 4))
+  {
+    gc_file_release(file);
+    return 0;
+  }
+  numEntries = (gc_int32)gauX_archive_read32(header + 8);
+  dirOffset = version == 2 ? gauX_archive_read64(header + 12) : gauX_archive_read32(header + 12);
+  if(numEntries < 0 || dirOffset < headerSize || dirOffset > file->size ||
+     file->size - dirOffset > 0x7fffffff)
+  {
+    gc_file_release(file);
+    return 0;
+  }
+  dirSize = (gc_int32)(file->size - dirOffset);
+  if(numEntries > dirSize / entrySize)
+  {
+    gc_file_release(file);
+    return 0;
+  }
+  ret = gcX_ops->allocFunc(sizeof(gau_Archive));
+  ret->file = file;
+  ret->numEntries = numEntries;
+  ret->directory = gcX_ops->allocFunc(dirSize ? dirSize : 1);
+  ret->tableSize = 2;
+  while(ret->tableSize < (gc_uint32)numEntries * 2)
+    ret->tableSize <<= 1;
+  ret->table = gcX_ops->allocFunc(ret->tableSize * sizeof(gauX_ArchiveEntry));
+  memset(ret->table, 0, ret->tableSize * sizeof(gauX_ArchiveEntry));
+  if(gc_file_read_at(file, ret->directory, dirSize, dirOffset) != dirSize)
+    numEntries = -1;
+  for(i = 0; i < numEntries; ++i)
+  {
+    gauX_ArchiveEntry entry;
+    gc_uint32 slot;
+    const char* d = ret->directory + pos;
+    if(pos + entrySize > dirSize)
+      break;
+    entry.offset = version == 2 ? gauX_archive_read64(d) : gauX_archive_read32(d);
+    entry.size = version == 2 ? gauX_archive_read64(d + 8) : gauX_archive_read32(d + 4);
+    entry.nameLength = (gc_uint8)d[entrySize - 2] | ((gc_uint8)d[entrySize - 1] << 8);
+    entry.name = d + entrySize;
+    pos += entrySize + entry.nameLength;
+    if(pos > dirSize || entry.offset < 0 || entry.size < 0 || entry.offset > file->size - entry.size)
+      break;
+    entry.hash = gauX_archive_hash(entry.name, entry.nameLength);
+    slot = entry.hash & (ret->tableSize - 1);
+    while(ret->table[slot].name)
+      slot = (slot + 1) & (ret->tableSize - 1);
+    ret->table[slot] = entry;
+  }
+  if(i != numEntries)
+  {
+    /* Truncated or corrupt directory */
+    gau_archive_close(ret);
+    return 0;
+  }
+  return ret;
+}
+ga_DataSource* gau_archive_open_entry(gau_Archive* in_archive, const char* in_name)
+{
+  gc_int32 length = (gc_int32)strlen(in_name);
+  gc_uint32 hash = gauX_archive_hash(in_name, length);
+  gc_uint32 slot = hash & (in_archive->tableSize - 1);
+  for(; in_archive->table[slot].name; slot = (slot + 1) & (in_archive->tableSize - 1))
+  {
+    gauX_ArchiveEntry* entry = &in_archive->table[slot];
+    if(entry->hash == hash && entry->nameLength == length && memcmp(entry->name, in_name, length) == 0)
+      return gau_data_source_create_file_shared(in_archive->file, entry->offset, entry->size);
+  }
+  return 0;
 }
+gc_int32 gau_archive_num_entries(gau_Archive* in_archive)
+{
+  return in_archive->numEntries;
+}
+void gau_archive_close(gau_Archive* in_archive)
+{
+  gc_file_release(in_archive->file); /* Open entries keep their own reference */
+  gcX_ops->freeFunc(in_archive->table);
+  gcX_ops->freeFunc(in_archive->directory);
+  gcX_ops->freeFunc(in_archive);
+}
+
+/* Sound Bank */
+#define GAUX_SOUND_BANK_HEADER_SIZE 16
+#define GAUX_SOUND_BANK_ENTRY_SIZE 18 /* Index entry size, excluding the name */
 
+typedef struct gauX_SoundBankEntry {
+  const char* name; /* 0 for an empty slot */
+  gc_int32 nameLength;
+  gc_uint32 hash;
+  ga_Sound* sound;
+} gauX_SoundBankEntry;
+
+struct gau_SoundBank {
+  ga_Memory* memory; /* Mapping of the whole bank file */
+  gauX_SoundBankEntry* table; /* Open-addressed hash index */
+  gc_uint32 tableSize; /* Power of two, at least twice the sound count */
+  gc_int32 numSounds;
+};
+
+static void gauX_sound_bank_write32(char* out_data, gc_uint32 in_value)
+{
+  out_data[0] = (char)(in_value & 0xff);
+  out_data[1] = (char)((in_value >> 8) & 0xff);
+  out_data[2] = (char)((in_value >> 16) & 0xff);
+  out_data[3] = (char)((in_value >> 24) & 0xff);
+}
+static void gauX_sound_bank_write16(char* out_data, gc_uint32 in_value)
+{
+  out_data[0] = (char)(in_value & 0xff);
+  out_data[1] = (char)((in_value >> 8) & 0xff);
+}
+static gc_uint32 gauX_sound_bank_read16(const char* in_data)
+{
+  const gc_uint8* d = (const gc_uint8*)in_data;
+  return d[0] | (d[1] << 8);
+}
+gau_SoundBank* gau_sound_bank_open(const char* in_filename)
+{
+  gau_SoundBank* ret;
+  ga_Memory* memory;
+  const char* data;
+  gc_int64 size;
+  gc_int32 numSounds, pos;
+  gc_int32 i;
+  memory = ga_memory_create_mapped(in_filename);
+  if(!memory)
+    return 0;
+  data = (const char*)ga_memory_data(memory);
+  size = ga_memory_size64(memory);
+  if(size < GAUX_SOUND_BANK_HEADER_SIZE ||
+     memcmp(data, "GBNK", 4) != 0 || gauX_archive_read32(data + 4) != 1)
+  {
+    ga_memory_release(memory);
+    return 0;
+  }
+  numSounds = (gc_int32)gauX_archive_read32(data + 8);
+  pos = (gc_int32)gauX_archive_read32(data + 12);
+  if(numSounds < 0 || pos < GAUX_SOUND_BANK_HEADER_SIZE || pos > size ||
+     numSounds > (size - pos) / GAUX_SOUND_BANK_ENTRY_SIZE)
+  {
+    ga_memory_release(memory);
+    return 0;
+  }
+  ret = gcX_ops->allocFunc(sizeof(gau_SoundBank));
+  ret->memory = memory;
+  ret->numSounds = numSounds;
+  ret->tableSize = 2;
+  while(ret->tableSize < (gc_uint32)numSounds * 2)
+    ret->tableSize <<= 1;
+  ret->table = gcX_ops->allocFunc(ret->tableSize * sizeof(gauX_SoundBankEntry));
+  memset(ret->table, 0, ret->tableSize * sizeof(gauX_SoundBankEntry));
+  for(i = 0; i < numSounds; ++i)
+  {
+    gauX_SoundBankEntry entry;
+    ga_Format format;
+    ga_Memory* view;
+    gc_int32 offset, dataSize;
+    gc_uint32 slot;
+    if(pos + GAUX_SOUND_BANK_ENTRY_SIZE > size)
+      break;
+    offset = (gc_int32)gauX_archive_read32(data + pos);
+    dataSize = (gc_int32)gauX_archive_read32(data + pos + 4);
+    format.sampleRate = (gc_int32)gauX_archive_read32(data + pos + 8);
+    format.bitsPerSample = (gc_int32)gauX_sound_bank_read16(data + pos + 12);
+    format.numChannels = (gc_int32)gauX_sound_bank_read16(data + pos + 14);
+    entry.nameLength = (gc_int32)gauX_sound_bank_read16(data + pos + 16);
+    entry.name = data + pos + GAUX_SOUND_BANK_ENTRY_SIZE;
+    pos += GAUX_SOUND_BANK_ENTRY_SIZE + entry.nameLength;
+    if(pos > size || format.sampleRate <= 0 || format.numChannels <= 0 ||
+       (format.bitsPerSample != 8 && format.bitsPerSample != 16))
+      break;
+    view = ga_memory_create_view(memory, offset, dataSize);
+    if(!view)
+      break;
+    entry.sound = ga_sound_create(view, &format);
+    ga_memory_release(view); /* The sound holds its own reference */
+    entry.hash = gauX_archive_hash(entry.name, entry.nameLength);
+    slot = entry.hash & (ret->tableSize - 1);
+    while(ret->table[slot].name)
+      slot = (slot + 1) & (ret->tableSize - 1);
+    ret->table[slot] = entry;
+  }
+  if(i != numSounds)
+  {
+    /* Truncated or corrupt index */
+    gau_sound_bank_close(ret);
+    return 0;
+  }
+  return ret;
+}
+ga_Sound* gau_sound_bank_sound(gau_SoundBank* in_bank, const char* in_name)
+{
+  gc_int32 length = (gc_int32)strlen(in_name);
+  gc_uint32 hash = gauX_archive_hash(in_name, length);
+  gc_uint32 slot = hash & (in_bank->tableSize - 1);
+  for(; in_bank->table[slot].name; slot = (slot + 1) & (in_bank->tableSize - 1))
+  {
+    gauX_SoundBankEntry* entry = &in_bank->table[slot];
+    if(entry->hash == hash && entry->nameLength == length && memcmp(entry->name, in_name, length) == 0)
+    {
+      ga_sound_acquire(entry->sound);
+      return entry->sound;
+    }
+  }
+  return 0;
+}
+gc_int32 gau_sound_bank_num_sounds(gau_SoundBank* in_bank)
+{
+  return in_bank->numSounds;
+}
+void gau_sound_bank_close(gau_SoundBank* in_bank)
+{
+  gc_uint32 i;
+  for(i = 0; i < in_bank->tableSize; ++i)
+  {
+    if(in_bank->table[i].name)
+      ga_sound_release(in_bank->table[i].sound); /* Retrieved sounds keep the mapping alive */
+  }
+  ga_memory_release(in_bank->memory);
+  gcX_ops->freeFunc(in_bank->table);
+  gcX_ops->freeFunc(in_bank);
+}
+gc_result gau_sound_bank_write(const char* in_filename, gc_int32 in_numSounds,
+                               const char** in_names, ga_Sound** in_sounds)
+{
+  FILE* f;
+  char* index;
+  gc_int32 indexSize = 0;
+  gc_int32 dataOffset, pos = 0;
+  gc_int32 i;
+  gc_result ret = GC_SUCCESS;
+  char header[GAUX_SOUND_BANK_HEADER_SIZE];
+  char padding[GAU_SOUND_BANK_ALIGNMENT];
+  for(i = 0; i < in_numSounds; ++i)
+  {
+    gc_int32 nameLength = (gc_int32)strlen(in_names[i]);
+    if(nameLength > 0xffff)
+      return GC_ERROR_GENERIC;
+    indexSize += GAUX_SOUND_BANK_ENTRY_SIZE + nameLength;
+  }
+  f = fopen(in_filename, "wb");
+  if(!f)
+    return GC_ERROR_GENERIC;
+
+  /* Build the index, placing each sound's data on an aligned offset */
+  index = gcX_ops->allocFunc(indexSize ? indexSize : 1);
+  dataOffset = GAUX_SOUND_BANK_HEADER_SIZE + indexSize;
+  for(i = 0; i < in_numSounds; ++i)
+  {
+    ga_Format format;
+    gc_int32 nameLength = (gc_int32)strlen(in_names[i]);
+    ga_sound_format(in_sounds[i], &format);
+    dataOffset = (dataOffset + GAU_SOUND_BANK_ALIGNMENT - 1) & ~(GAU_SOUND_BANK_ALIGNMENT - 1);
+    gauX_sound_bank_write32(index + pos, (gc_uint32)dataOffset);
+    gauX_sound_bank_write32(index + pos + 4, (gc_uint32)ga_sound_size(in_sounds[i]));
+    gauX_sound_bank_write32(index + pos + 8, (gc_uint32)format.sampleRate);
+    gauX_sound_bank_write16(index + pos + 12, (gc_uint32)format.bitsPerSample);
+    gauX_sound_bank_write16(index + pos + 14, (gc_uint32)format.numChannels);
+    gauX_sound_bank_write16(index + pos + 16, (gc_uint32)nameLength);
+    memcpy(index + pos + GAUX_SOUND_BANK_ENTRY_SIZE, in_names[i], nameLength);
+    pos += GAUX_SOUND_BANK_ENTRY_SIZE + nameLength;
+    dataOffset += ga_sound_size(in_sounds[i]);
+  }
+  memcpy(header, "GBNK", 4);
+  gauX_sound_bank_write32(header + 4, 1);
+  gauX_sound_bank_write32(header + 8, (gc_uint32)in_numSounds);
+  gauX_sound_bank_write32(header + 12, GAUX_SOUND_BANK_HEADER_SIZE);
+  if(fwrite(header, 1, GAUX_SOUND_BANK_HEADER_SIZE, f) != GAUX_SOUND_BANK_HEADER_SIZE ||
+     fwrite(index, 1, indexSize, f) != (size_t)indexSize)
+    ret = GC_ERROR_GENERIC;
+
+  /* Write the PCM data, padded out to each aligned offset */
+  memset(padding, 0, GAU_SOUND_BANK_ALIGNMENT);
+  dataOffset = GAUX_SOUND_BANK_HEADER_SIZE + indexSize;
+  for(i = 0; i < in_numSounds && ret == GC_SUCCESS; ++i)
+  {
+    gc_int32 soundSize = ga_sound_size(in_sounds[i]);
+    gc_int32 padSize = ((dataOffset + GAU_SOUND_BANK_ALIGNMENT - 1) & ~(GAU_SOUND_BANK_ALIGNMENT - 1)) - dataOffset;
+    if(fwrite(padding, 1, padSize, f) != (size_t)padSize ||
+       fwrite(ga_sound_data(in_sounds[i]), 1, soundSize, f) != (size_t)soundSize)
+      ret = GC_ERROR_GENERIC;
+    dataOffset += padSize + soundSize;
+  }
+  gcX_ops->freeFunc(index);
+  if(fclose(f) != 0)
+    ret = GC_ERROR_GENERIC;
+  return ret;
+}
 
 /* Memory-Based Data Source */
 typedef struct gau_DataSourceMemoryContext {
   ga_Memory* memory;
-  gc_int32 pos;
+  gc_int64 pos;
   gc_Mutex* memMutex;
 } gau_DataSourceMemoryContext;
 
@@ -348,13 +1447,13 @@ gc_int32 gauX_data_source_memory_read(void* in_context, void* in_dst, gc_int32 i
 {
   gau_DataSourceMemoryContext* ctx = (gau_DataSourceMemoryContext*)in_context;
   gc_int32 ret = 0;
-  gc_int32 dataSize = ga_memory_size(ctx->memory);
+  gc_int64 dataSize = ga_memory_size64(ctx->memory);
   gc_int32 toRead = in_size * in_count;
-  gc_int32 remaining;
+  gc_int64 remaining;
 
   gc_mutex_lock(ctx->memMutex);
   remaining = dataSize - ctx->pos;
-  toRead = toRead < remaining ? toRead : remaining;
+  toRead = toRead < remaining ? toRead : (gc_int32)remaining;
   toRead = toRead - (toRead % in_size);
   if(toRead)
   {
@@ -365,25 +1464,39 @@ gc_int32 gauX_data_source_memory_read(void* in_context, void* in_dst, gc_int32 i
   gc_mutex_unlock(ctx->memMutex);
   return ret;
 }
-gc_int32 gauX_data_source_memory_seek(void* in_context, gc_int32 in_offset, gc_int32 in_origin)
+gc_int32 gauX_data_source_memory_borrow(void* in_context, gc_int32 in_maxBytes, const void** out_data)
 {
   gau_DataSourceMemoryContext* ctx = (gau_DataSourceMemoryContext*)in_context;
-  gc_int32 dataSize = ga_memory_size(ctx->memory);
+  gc_int64 dataSize = ga_memory_size64(ctx->memory);
+  gc_int32 bytes;
   gc_mutex_lock(ctx->memMutex);
+  bytes = dataSize - ctx->pos < in_maxBytes ? (gc_int32)(dataSize - ctx->pos) : in_maxBytes;
+  *out_data = (char*)ga_memory_data(ctx->memory) + ctx->pos;
+  ctx->pos += bytes;
+  gc_mutex_unlock(ctx->memMutex);
+  return bytes;
+}
+gc_int32 gauX_data_source_memory_seek(void* in_context, gc_int64 in_offset, gc_int32 in_origin)
+{
+  gau_DataSourceMemoryContext* ctx = (gau_DataSourceMemoryContext*)in_context;
+  gc_int64 dataSize = ga_memory_size64(ctx->memory);
+  gc_int64 pos;
+  gc_mutex_lock(ctx->memMutex);
+  pos = ctx->pos;
   switch(in_origin)
   {
-  case GA_SEEK_ORIGIN_SET: ctx->pos = in_offset; break;
-  case GA_SEEK_ORIGIN_CUR: ctx->pos += in_offset; break;
-  case GA_SEEK_ORIGIN_END: ctx->pos = dataSize - in_offset; break;
+  case GA_SEEK_ORIGIN_SET: pos = in_offset; break;
+  case GA_SEEK_ORIGIN_CUR: pos += in_offset; break;
+  case GA_SEEK_ORIGIN_END: pos = dataSize - in_offset; break;
   }
-  ctx->pos = ctx->pos < 0 ? 0 : ctx->pos > dataSize ? dataSize : ctx->pos;
+  ctx->pos = pos < 0 ? 0 : pos > dataSize ? dataSize : pos;
   gc_mutex_unlock(ctx->memMutex);
   return 0;
 }
-gc_int32 gauX_data_source_memory_tell(void* in_context)
+gc_int64 gauX_data_source_memory_tell(void* in_context)
 {
   gau_DataSourceMemoryContext* ctx = (gau_DataSourceMemoryContext*)in_context;
-  gc_int32 ret;
+  gc_int64 ret;
   gc_mutex_lock(ctx->memMutex);
   ret = ctx->pos;
   gc_mutex_unlock(ctx->memMutex);
@@ -403,21 +1516,183 @@ ga_DataSource* gau_data_source_create_memory(ga_Memory* in_memory)
   ret->dataSrc.readFunc = &gauX_data_source_memory_read;
   ret->dataSrc.seekFunc = &gauX_data_source_memory_seek;
   ret->dataSrc.tellFunc = &gauX_data_source_memory_tell;
+  ret->dataSrc.borrowFunc = &gauX_data_source_memory_borrow;
   ret->dataSrc.closeFunc = &gauX_data_source_memory_close;
   ga_memory_acquire(in_memory);
   ret->context.memory = in_memory;
   ret->context.pos = 0;
-  ret->context.memMutex = gc_mutex_create();
+  ret->context.memMutex = gc_mutex_create_named("gau_DataSourceMemory::memMutex");
+  return (ga_DataSource*)ret;
+}
+ga_DataSource* gau_data_source_create_mmap(const char* in_filename)
+{
+  ga_DataSource* ret;
+  ga_Memory* memory = ga_memory_create_mapped(in_filename);
+  if(!memory)
+    return 0;
+  ret = gau_data_source_create_memory(memory);
+  ga_memory_release(memory); /* The data source holds its own reference */
+  return ret;
+}
+
+/* Buffered Data Source */
+typedef struct gau_DataSourceBufferedContext {
+  ga_DataSource* dataSrc;
+  gc_int32 bufferSize;
+  char* buffer;
+  const char* block; /* Buffered bytes: 'buffer', or bytes borrowed from the source */
+  gc_int64 bufferStart; /* Source position of the block's first byte */
+  gc_int32 bufferValid; /* Valid bytes in the block */
+  gc_int32 bufferPos; /* Read position within the block */
+} gau_DataSourceBufferedContext;
+
+typedef struct gau_DataSourceBuffered {
+  ga_DataSource dataSrc;
+  gau_DataSourceBufferedContext context;
+} gau_DataSourceBuffered;
+
+static gc_int32 gauX_data_source_buffered_fill(gau_DataSourceBufferedContext* in_ctx)
+{
+  /* Borrow the next block from the source if it can lend it, instead of copying it */
+  const void* data;
+  gc_int32 numBytes = ga_data_source_borrow(in_ctx->dataSrc, in_ctx->bufferSize, &data);
+  in_ctx->bufferStart += in_ctx->bufferValid;
+  in_ctx->bufferPos = 0;
+  if(numBytes >= 0)
+    in_ctx->block = (const char*)data;
+  else
+  {
+    numBytes = ga_data_source_read(in_ctx->dataSrc, in_ctx->buffer, 1, in_ctx->bufferSize);
+    in_ctx->block = in_ctx->buffer;
+  }
+  in_ctx->bufferValid = numBytes > 0 ? numBytes : 0;
+  return in_ctx->bufferValid;
+}
+gc_int32 gauX_data_source_buffered_read(void* in_context, void* in_dst, gc_int32 in_size, gc_int32 in_count)
+{
+  /* No lock: single client (see gau_data_source_create_buffered()) */
+  gau_DataSourceBufferedContext* ctx = (gau_DataSourceBufferedContext*)in_context;
+  gc_int32 toRead = in_size * in_count;
+  gc_int32 numRead = 0;
+  while(numRead < toRead)
+  {
+    gc_int32 bytes = ctx->bufferValid - ctx->bufferPos;
+    if(bytes <= 0)
+    {
+      gc_int32 remaining = toRead - numRead;
+      if(remaining >= ctx->bufferSize && ctx->block == ctx->buffer)
+      {
+        /* Large read; bypass the buffer */
+        ctx->bufferStart += ctx->bufferValid;
+        ctx->bufferValid = 0;
+        ctx->bufferPos = 0;
+        bytes = ga_data_source_read(ctx->dataSrc, (char*)in_dst + numRead, 1, remaining);
+        if(bytes <= 0)
+          break;
+        ctx->bufferStart += bytes;
+        numRead += bytes;
+        continue;
+      }
+      if(!gauX_data_source_buffered_fill(ctx))
+        break;
+      continue;
+    }
+    bytes = bytes < toRead - numRead ? bytes : toRead - numRead;
+    memcpy((char*)in_dst + numRead, ctx->block + ctx->bufferPos, bytes);
+    numRead += bytes;
+    ctx->bufferPos += bytes;
+  }
+  return numRead / in_size;
+}
+gc_int32 gauX_data_source_buffered_borrow(void* in_context, gc_int32 in_maxBytes, const void** out_data)
+{
+  gau_DataSourceBufferedContext* ctx = (gau_DataSourceBufferedContext*)in_context;
+  gc_int32 bytes;
+  if(ctx->bufferPos == ctx->bufferValid && !gauX_data_source_buffered_fill(ctx))
+    return 0;
+  bytes = ctx->bufferValid - ctx->bufferPos;
+  bytes = bytes < in_maxBytes ? bytes : in_maxBytes;
+  *out_data = ctx->block + ctx->bufferPos;
+  ctx->bufferPos += bytes;
+  return bytes;
+}
+gc_int32 gauX_data_source_buffered_seek(void* in_context, gc_int64 in_offset, gc_int32 in_origin)
+{
+  gau_DataSourceBufferedContext* ctx = (gau_DataSourceBufferedContext*)in_context;
+  if(in_origin == GA_SEEK_ORIGIN_CUR)
+  {
+    in_offset += ctx->bufferStart + ctx->bufferPos;
+    in_origin = GA_SEEK_ORIGIN_SET;
+  }
+  if(in_origin == GA_SEEK_ORIGIN_SET && in_offset >= ctx->bufferStart &&
+     in_offset <= ctx->bufferStart + ctx->bufferValid)
+  {
+    /* Within the block */
+    ctx->bufferPos = (gc_int32)(in_offset - ctx->bufferStart);
+    return 0;
+  }
+  if(ga_data_source_seek64(ctx->dataSrc, in_offset, in_origin) < 0)
+  {
+    /* Stay at the same position. A block in our own buffer is kept, with the
+       source put back where the block's read left it; borrowed bytes don't
+       survive a seek on the source, so that block is read again instead. */
+    if(ctx->block != ctx->buffer)
+    {
+      ga_data_source_seek64(ctx->dataSrc, ctx->bufferStart + ctx->bufferPos, GA_SEEK_ORIGIN_SET);
+      ctx->bufferStart = ga_data_source_tell64(ctx->dataSrc);
+      ctx->bufferValid = 0;
+      ctx->bufferPos = 0;
+    }
+    else if(ga_data_source_tell64(ctx->dataSrc) != ctx->bufferStart + ctx->bufferValid)
+      ga_data_source_seek64(ctx->dataSrc, ctx->bufferStart + ctx->bufferValid, GA_SEEK_ORIGIN_SET);
+    return -1;
+  }
+  ctx->bufferStart = ga_data_source_tell64(ctx->dataSrc);
+  ctx->bufferValid = 0;
+  ctx->bufferPos = 0;
+  return 0;
+}
+gc_int64 gauX_data_source_buffered_tell(void* in_context)
+{
+  gau_DataSourceBufferedContext* ctx = (gau_DataSourceBufferedContext*)in_context;
+  return ctx->bufferStart + ctx->bufferPos;
+}
+void gauX_data_source_buffered_close(void* in_context)
+{
+  gau_DataSourceBufferedContext* ctx = (gau_DataSourceBufferedContext*)in_context;
+  ga_data_source_release(ctx->dataSrc);
+  gcX_ops->freeFunc(ctx->buffer);
+}
+ga_DataSource* gau_data_source_create_buffered(ga_DataSource* in_dataSrc, gc_int32 in_bufferSize)
+{
+  gau_DataSourceBuffered* ret = gcX_ops->allocFunc(sizeof(gau_DataSourceBuffered));
+  ga_data_source_init(&ret->dataSrc);
+  ret->dataSrc.flags = ga_data_source_flags(in_dataSrc) & GA_FLAG_SEEKABLE;
+  ret->dataSrc.readFunc = &gauX_data_source_buffered_read;
+  ret->dataSrc.seekFunc = &gauX_data_source_buffered_seek;
+  ret->dataSrc.tellFunc = &gauX_data_source_buffered_tell;
+  ret->dataSrc.borrowFunc = &gauX_data_source_buffered_borrow;
+  ret->dataSrc.closeFunc = &gauX_data_source_buffered_close;
+  ga_data_source_acquire(in_dataSrc);
+  ret->context.dataSrc = in_dataSrc;
+  ret->context.bufferSize = in_bufferSize;
+  ret->context.buffer = gcX_ops->allocFunc(in_bufferSize);
+  ret->context.block = ret->context.buffer;
+  ret->context.bufferStart = ga_data_source_tell64(in_dataSrc);
+  ret->context.bufferValid = 0;
+  ret->context.bufferPos = 0;
   return (ga_DataSource*)ret;
 }
 
 /* WAV Sample Source */
+#define GAUX_WAV_BUFFER_SIZE 4096 /* Buffers the many small header reads */
+
 typedef struct ga_WavData
 {
   gc_int32 fileSize;
   gc_int16 fmtTag, channels, blockAlign, bitsPerSample;
   gc_int32 fmtSize, sampleRate, bytesPerSec;
-  gc_int32 dataOffset, dataSize;
+  gc_int64 dataOffset, dataSize; /* RIFF sizes are unsigned, so data may exceed 2 GB */
 } ga_WavData;
 
 void gauX_data_source_advance(ga_DataSource* in_dataSrc, gc_int32 in_delta)
@@ -440,7 +1715,7 @@ gc_result gauX_sample_source_wav_load_header(ga_DataSource* in_dataSrc, ga_WavDa
   /* TODO: Make this work with non-blocking reads? Need to get this data... */
   ga_WavData* wavData = out_wavData;
   gc_int32 seekable = ga_data_source_flags(in_dataSrc) & GA_FLAG_SEEKABLE ? 1 : 0;
-  gc_int32 dataOffset = 0;
+  gc_int64 dataOffset = 0;
   char id[5];
   id[4] = 0;
   if(!in_dataSrc)
@@ -476,7 +1751,7 @@ gc_result gauX_sample_source_wav_load_header(ga_DataSource* in_dataSrc, ga_WavDa
         }
         else if(!dataFound && !strcmp(id, "data")) /* 'data' */
         {
-          wavData->dataSize = chunkSize;
+          wavData->dataSize = (gc_uint32)chunkSize;
           wavData->dataOffset = dataOffset;
           dataFound = 1;
         }
@@ -484,7 +1759,7 @@ gc_result gauX_sample_source_wav_load_header(ga_DataSource* in_dataSrc, ga_WavDa
         {
           gauX_data_source_advance(in_dataSrc, chunkSize);
         }
-        dataOffset += chunkSize;
+        dataOffset += (gc_uint32)chunkSize;
       } while(!(hdrFound && dataFound)); /* TODO: Need End-Of-Data support in Data Sources */
       if(hdrFound && dataFound)
         return GC_SUCCESS;
@@ -497,7 +1772,7 @@ typedef struct gau_SampleSourceWavContext {
   ga_DataSource* dataSrc;
   ga_WavData wavHeader;
   gc_int32 sampleSize;
-  gc_int32 pos;
+  gc_int64 pos;
   gc_Mutex* posMutex;
 } gau_SampleSourceWavContext;
 
@@ -511,10 +1786,10 @@ gc_int32 gauX_sample_source_wav_read(void* in_context, void* in_dst, gc_int32 in
 {
   gau_SampleSourceWavContext* ctx = &((gau_SampleSourceWav*)in_context)->context;
   gc_int32 numRead = 0;
-  gc_int32 totalSamples = ctx->wavHeader.dataSize / ctx->sampleSize;
+  gc_int64 totalSamples = ctx->wavHeader.dataSize / ctx->sampleSize;
   gc_mutex_lock(ctx->posMutex);
   if(ctx->pos + in_numSamples > totalSamples)
-    in_numSamples = totalSamples - ctx->pos;
+    in_numSamples = (gc_int32)(totalSamples - ctx->pos);
   if(in_numSamples > 0)
   {
     numRead = ga_data_source_read(ctx->dataSrc, in_dst, ctx->sampleSize, in_numSamples);
@@ -526,21 +1801,21 @@ gc_int32 gauX_sample_source_wav_read(void* in_context, void* in_dst, gc_int32 in
 gc_int32 gauX_sample_source_wav_end(void* in_context)
 {
   gau_SampleSourceWavContext* ctx = &((gau_SampleSourceWav*)in_context)->context;
-  gc_int32 totalSamples = ctx->wavHeader.dataSize / ctx->sampleSize;
+  gc_int64 totalSamples = ctx->wavHeader.dataSize / ctx->sampleSize;
   return ctx->pos == totalSamples; /* No need to mutex this use */
 }
-gc_int32 gauX_sample_source_wav_seek(void* in_context, gc_int32 in_sampleOffset)
+gc_int32 gauX_sample_source_wav_seek(void* in_context, gc_int64 in_sampleOffset)
 {
   gau_SampleSourceWavContext* ctx = &((gau_SampleSourceWav*)in_context)->context;
   gc_int32 ret;
   gc_mutex_lock(ctx->posMutex);
-  ret = ga_data_source_seek(ctx->dataSrc, ctx->wavHeader.dataOffset + in_sampleOffset * ctx->sampleSize, GA_SEEK_ORIGIN_SET);
+  ret = ga_data_source_seek64(ctx->dataSrc, ctx->wavHeader.dataOffset + in_sampleOffset * ctx->sampleSize, GA_SEEK_ORIGIN_SET);
   if(ret >= 0)
     ctx->pos = in_sampleOffset;
   gc_mutex_unlock(ctx->posMutex);
   return ret;
 }
-gc_int32 gauX_sample_source_wav_tell(void* in_context, gc_int32* out_totalSamples)
+gc_int64 gauX_sample_source_wav_tell(void* in_context, gc_int64* out_totalSamples)
 {
   gau_SampleSourceWavContext* ctx = &((gau_SampleSourceWav*)in_context)->context;
   if(out_totalSamples)
@@ -572,12 +1847,11 @@ ga_SampleSource* gau_sample_source_create_wav(ga_DataSource* in_dataSrc)
   }
   ret->sampleSrc.closeFunc = &gauX_sample_source_wav_close;
   ctx->pos = 0;
-  ga_data_source_acquire(in_dataSrc);
-  ctx->dataSrc = in_dataSrc;
-  validHeader = gauX_sample_source_wav_load_header(in_dataSrc, &ctx->wavHeader);
+  ctx->dataSrc = gau_data_source_create_buffered(in_dataSrc, GAUX_WAV_BUFFER_SIZE);
+  validHeader = gauX_sample_source_wav_load_header(ctx->dataSrc, &ctx->wavHeader);
   if(validHeader == GC_SUCCESS)
   {
-    ctx->posMutex = gc_mutex_create();
+    ctx->posMutex = gc_mutex_create_named("gau_SampleSourceWav::posMutex");
     ret->sampleSrc.format.numChannels = ctx->wavHeader.channels;
     ret->sampleSrc.format.bitsPerSample = ctx->wavHeader.bitsPerSample;
     ret->sampleSrc.format.sampleRate = ctx->wavHeader.sampleRate;
@@ -585,7 +1859,7 @@ ga_SampleSource* gau_sample_source_create_wav(ga_DataSource* in_dataSrc)
   }
   else
   {
-    ga_data_source_release(in_dataSrc);
+    ga_data_source_release(ctx->dataSrc);
     gcX_ops->freeFunc(ret);
     ret = 0;
   }
@@ -613,9 +1887,9 @@ int gauX_sample_source_ogg_callback_seek(void *datasource, ogg_int64_t offset, i
   ga_DataSource* ds = stream->dataSrc;
   switch(whence)
   {
-  case SEEK_SET: return ga_data_source_seek(ds, (gc_int32)offset, GA_SEEK_ORIGIN_SET);
-  case SEEK_CUR: return ga_data_source_seek(ds, (gc_int32)offset, GA_SEEK_ORIGIN_CUR);
-  case SEEK_END: return ga_data_source_seek(ds, (gc_int32)offset, GA_SEEK_ORIGIN_END);
+  case SEEK_SET: return ga_data_source_seek64(ds, offset, GA_SEEK_ORIGIN_SET);
+  case SEEK_CUR: return ga_data_source_seek64(ds, offset, GA_SEEK_ORIGIN_CUR);
+  case SEEK_END: return ga_data_source_seek64(ds, offset, GA_SEEK_ORIGIN_END);
   }
   return -1;
 }
@@ -623,7 +1897,7 @@ long gauX_sample_source_ogg_callback_tell(void *datasource)
 {
   gau_OggDataSourceCallbackData* stream = (gau_OggDataSourceCallbackData*)datasource;
   ga_DataSource* ds = stream->dataSrc;
-  return ga_data_source_tell(ds);
+  return (long)ga_data_source_tell64(ds);
 }
 int gauX_sample_source_ogg_callback_close(void *datasource)
 {
@@ -734,7 +2008,7 @@ gc_int32 gauX_sample_source_ogg_end(void* in_context)
   gau_SampleSourceOggContext* ctx = &((gau_SampleSourceOgg*)in_context)->context;
   return ctx->endOfSamples; /* No need for a mutex here */
 }
-gc_int32 gauX_sample_source_ogg_seek(void* in_context, gc_int32 in_sampleOffset)
+gc_int32 gauX_sample_source_ogg_seek(void* in_context, gc_int64 in_sampleOffset)
 {
   gau_SampleSourceOggContext* ctx = &((gau_SampleSourceOgg*)in_context)->context;
   gc_int32 ret;
@@ -744,15 +2018,15 @@ gc_int32 gauX_sample_source_ogg_seek(void* in_context, gc_int32 in_sampleOffset)
   gc_mutex_unlock(ctx->oggMutex);
   return ret;
 }
-gc_int32 gauX_sample_source_ogg_tell(void* in_context, gc_int32* out_totalSamples)
+gc_int64 gauX_sample_source_ogg_tell(void* in_context, gc_int64* out_totalSamples)
 {
   gau_SampleSourceOggContext* ctx = &((gau_SampleSourceOgg*)in_context)->context;
-  gc_int32 ret;
+  gc_int64 ret;
   gc_mutex_lock(ctx->oggMutex);
   /* TODO: Decide whether to support total samples for OGG files */
   if(out_totalSamples)
     *out_totalSamples = ov_pcm_total(&ctx->oggFile, -1); /* Note: This isn't always valid when the stream is poorly-formatted */
-  ret = (gc_int32)ov_pcm_tell(&ctx->oggFile);
+  ret = ov_pcm_tell(&ctx->oggFile);
   gc_mutex_unlock(ctx->oggMutex);
   return ret;
 }
@@ -819,7 +2093,7 @@ ga_SampleSource* gau_sample_source_create_ogg(ga_DataSource* in_dataSrc)
       ov_clear(&ctx->oggFile);
   }
   if(isValidOgg)
-    ctx->oggMutex = gc_mutex_create();
+    ctx->oggMutex = gc_mutex_create_named("gau_SampleSourceOgg::oggMutex");
   else
   {
     ga_data_source_release(in_dataSrc);
@@ -847,6 +2121,18 @@ gc_int32 gauX_sample_source_stream_read(void* in_context, void* in_dst, gc_int32
   numRead = ga_stream_read(ctx->stream, in_dst, in_numSamples);
   return numRead;
 }
+gc_int32 gauX_sample_source_stream_peek(void* in_context, gc_int32 in_numSamples,
+                                        void** out_dataA, gc_int32* out_samplesA,
+                                        void** out_dataB, gc_int32* out_samplesB)
+{
+  gau_SampleSourceStreamContext* ctx = &((gau_SampleSourceStream*)in_context)->context;
+  return ga_stream_peek(ctx->stream, in_numSamples, out_dataA, out_samplesA, out_dataB, out_samplesB);
+}
+void gauX_sample_source_stream_commit(void* in_context, gc_int32 in_numSamples)
+{
+  gau_SampleSourceStreamContext* ctx = &((gau_SampleSourceStream*)in_context)->context;
+  ga_stream_commit(ctx->stream, in_numSamples);
+}
 gc_int32 gauX_sample_source_stream_end(void* in_context)
 {
   gau_SampleSourceStreamContext* ctx = &((gau_SampleSourceStream*)in_context)->context;
@@ -857,15 +2143,15 @@ gc_int32 gauX_sample_source_stream_ready(void* in_context, gc_int32 in_numSample
   gau_SampleSourceStreamContext* ctx = &((gau_SampleSourceStream*)in_context)->context;
   return ga_stream_ready(ctx->stream, in_numSamples);
 }
-gc_int32 gauX_sample_source_stream_seek(void* in_context, gc_int32 in_sampleOffset)
+gc_int32 gauX_sample_source_stream_seek(void* in_context, gc_int64 in_sampleOffset)
 {
   gau_SampleSourceStreamContext* ctx = &((gau_SampleSourceStream*)in_context)->context;
-  return ga_stream_seek(ctx->stream, in_sampleOffset);
+  return ga_stream_seek64(ctx->stream, in_sampleOffset);
 }
-gc_int32 gauX_sample_source_stream_tell(void* in_context, gc_int32* out_totalSamples)
+gc_int64 gauX_sample_source_stream_tell(void* in_context, gc_int64* out_totalSamples)
 {
   gau_SampleSourceStreamContext* ctx = &((gau_SampleSourceStream*)in_context)->context;
-  return ga_stream_tell(ctx->stream, out_totalSamples);
+  return ga_stream_tell64(ctx->stream, out_totalSamples);
 }
 void gauX_sample_source_stream_close(void* in_context)
 {
@@ -890,6 +2176,8 @@ ga_SampleSource* gau_sample_source_create_stream(ga_StreamManager* in_mgr, ga_Sa
     ret->sampleSrc.readFunc = &gauX_sample_source_stream_read;
     ret->sampleSrc.endFunc = &gauX_sample_source_stream_end;
     ret->sampleSrc.readyFunc = &gauX_sample_source_stream_ready;
+    ret->sampleSrc.peekFunc = &gauX_sample_source_stream_peek;
+    ret->sampleSrc.commitFunc = &gauX_sample_source_stream_commit;
     if(ret->sampleSrc.flags & GA_FLAG_SEEKABLE)
     {
       ret->sampleSrc.seekFunc = &gauX_sample_source_stream_seek;
@@ -908,8 +2196,8 @@ ga_SampleSource* gau_sample_source_create_stream(ga_StreamManager* in_mgr, ga_Sa
 /* Loop Sample Source */
 typedef struct gau_SampleSourceLoopContext {
   ga_SampleSource* innerSrc;
-  gc_int32 triggerSample;
-  gc_int32 targetSample;
+  gc_int64 triggerSample;
+  gc_int64 targetSample;
   gc_Mutex* loopMutex;
   gc_int32 sampleSize;
   volatile gc_int32 loopCount;
@@ -925,8 +2213,8 @@ gc_int32 gauX_sample_source_loop_read(void* in_context, void* in_dst, gc_int32 i
 {
   gau_SampleSourceLoopContext* ctx = &((gau_SampleSourceLoop*)in_context)->context;
   gc_int32 numRead = 0;
-  gc_int32 triggerSample, targetSample;
-  gc_int32 pos, total;
+  gc_int64 triggerSample, targetSample;
+  gc_int64 pos, total;
   gc_int32 sampleSize;
   gc_int32 totalRead = 0;
   ga_SampleSource* ss = ctx->innerSrc;
@@ -934,7 +2222,7 @@ gc_int32 gauX_sample_source_loop_read(void* in_context, void* in_dst, gc_int32 i
   triggerSample = ctx->triggerSample;
   targetSample = ctx->targetSample;
   gc_mutex_unlock(ctx->loopMutex);
-  pos = ga_sample_source_tell(ss, &total);
+  pos = ga_sample_source_tell64(ss, &total);
   if((targetSample < 0 && triggerSample <= 0))
     return ga_sample_source_read(ss, in_dst, in_numSamples, 0, 0);
   if(triggerSample <= 0)
@@ -944,21 +2232,21 @@ gc_int32 gauX_sample_source_loop_read(void* in_context, void* in_dst, gc_int32 i
   sampleSize = ctx->sampleSize;
   while(in_numSamples)
   {
-    gc_int32 avail = triggerSample - pos;
+    gc_int64 avail = triggerSample - pos;
     gc_int32 doSeek = avail <= in_numSamples;
-    gc_int32 toRead = doSeek ? avail : in_numSamples;
+    gc_int32 toRead = doSeek ? (gc_int32)avail : in_numSamples;
     numRead = ga_sample_source_read(ss, in_dst,  toRead, 0, 0);
     totalRead += numRead;
     in_numSamples -= numRead;
     in_dst = (char*)in_dst + numRead * sampleSize;
     if(doSeek && toRead == numRead)
     {
-      ga_sample_source_seek(ss, targetSample);
+      ga_sample_source_seek64(ss, targetSample);
       ++ctx->loopCount;
       if(in_onSeekFunc)
         in_onSeekFunc(totalRead, targetSample - triggerSample, in_seekContext);
     }
-    pos = ga_sample_source_tell(ss, &total);
+    pos = ga_sample_source_tell64(ss, &total);
   }
   return totalRead;
 }
@@ -972,15 +2260,15 @@ gc_int32 gauX_sample_source_loop_ready(void* in_context, gc_int32 in_numSamples)
   gau_SampleSourceLoopContext* ctx = &((gau_SampleSourceLoop*)in_context)->context;
   return ga_sample_source_ready(ctx->innerSrc, in_numSamples);
 }
-gc_int32 gauX_sample_source_loop_seek(void* in_context, gc_int32 in_sampleOffset)
+gc_int32 gauX_sample_source_loop_seek(void* in_context, gc_int64 in_sampleOffset)
 {
   gau_SampleSourceLoopContext* ctx = &((gau_SampleSourceLoop*)in_context)->context;
-  return ga_sample_source_seek(ctx->innerSrc, in_sampleOffset);
+  return ga_sample_source_seek64(ctx->innerSrc, in_sampleOffset);
 }
-gc_int32 gauX_sample_source_loop_tell(void* in_context, gc_int32* out_totalSamples)
+gc_int64 gauX_sample_source_loop_tell(void* in_context, gc_int64* out_totalSamples)
 {
   gau_SampleSourceLoopContext* ctx = &((gau_SampleSourceLoop*)in_context)->context;
-  return ga_sample_source_tell(ctx->innerSrc, out_totalSamples);
+  return ga_sample_source_tell64(ctx->innerSrc, out_totalSamples);
 }
 void gauX_sample_source_loop_close(void* in_context)
 {
@@ -989,6 +2277,10 @@ void gauX_sample_source_loop_close(void* in_context)
   ga_sample_source_release(ctx->innerSrc);
 }
 void gau_sample_source_loop_set(gau_SampleSourceLoop* in_sampleSrc, gc_int32 in_triggerSample, gc_int32 in_targetSample)
+{
+  gau_sample_source_loop_set64(in_sampleSrc, in_triggerSample, in_targetSample);
+}
+void gau_sample_source_loop_set64(gau_SampleSourceLoop* in_sampleSrc, gc_int64 in_triggerSample, gc_int64 in_targetSample)
 {
   gau_SampleSourceLoopContext* ctx = &in_sampleSrc->context;
   gc_mutex_lock(ctx->loopMutex);
@@ -1018,7 +2310,7 @@ gau_SampleSourceLoop* gau_sample_source_create_loop(ga_SampleSource* in_sampleSr
   ctx->triggerSample = -1;
   ctx->targetSample = -1;
   ctx->loopCount = 0;
-  ctx->loopMutex = gc_mutex_create();
+  ctx->loopMutex = gc_mutex_create_named("gau_SampleSourceLoop::loopMutex");
   ctx->innerSrc = in_sampleSrc;
   ctx->sampleSize = sampleSize;
   ret->sampleSrc.flags = ga_sample_source_flags(in_sampleSrc);
@@ -1062,7 +2354,7 @@ gc_int32 gauX_sample_source_sound_read(void* in_context, void* in_dst, gc_int32
   numRead = in_numSamples > avail ? avail : in_numSamples;
   ctx->pos += numRead;
   gc_mutex_unlock(ctx->posMutex);
-  src = (char*)ga_sound_data(snd) + pos * ctx->sampleSize;
+  src = (char*)ga_sound_data(snd) + (size_t)pos * ctx->sampleSize;
   memcpy(in_dst, src, numRead * ctx->sampleSize);
   return numRead;
 }
@@ -1071,20 +2363,21 @@ gc_int32 gauX_sample_source_sound_end(void* in_context)
   gau_SampleSourceSoundContext* ctx = &((gau_SampleSourceSound*)in_context)->context;
   return ctx->pos >= ctx->numSamples;
 }
-gc_int32 gauX_sample_source_sound_seek(void* in_context, gc_int32 in_sampleOffset)
+gc_int32 gauX_sample_source_sound_seek(void* in_context, gc_int64 in_sampleOffset)
 {
   gau_SampleSourceSoundContext* ctx = &((gau_SampleSourceSound*)in_context)->context;
-  if(in_sampleOffset > ctx->numSamples)
+  if(in_sampleOffset < 0 || in_sampleOffset > ctx->numSamples)
     return -1;
   gc_mutex_lock(ctx->posMutex);
-  ctx->pos = in_sampleOffset;
+  ctx->pos = (gc_int32)in_sampleOffset;
   gc_mutex_unlock(ctx->posMutex);
   return 0;
 }
-gc_int32 gauX_sample_source_sound_tell(void* in_context, gc_int32* out_totalSamples)
+gc_int64 gauX_sample_source_sound_tell(void* in_context, gc_int64* out_totalSamples)
 {
   gau_SampleSourceSoundContext* ctx = &((gau_SampleSourceSound*)in_context)->context;
-  *out_totalSamples = ctx->numSamples;
+  if(out_totalSamples)
+    *out_totalSamples = ctx->numSamples;
   return ctx->pos;
 }
 void gauX_sample_source_sound_close(void* in_context)
@@ -1102,7 +2395,7 @@ ga_SampleSource* gau_sample_source_create_sound(ga_Sound* in_sound)
   ga_sound_acquire(in_sound);
   ga_sound_format(in_sound, &ret->sampleSrc.format);
   sampleSize = ga_format_sampleSize(&ret->sampleSrc.format);
-  ctx->posMutex = gc_mutex_create();
+  ctx->posMutex = gc_mutex_create_named("gau_SampleSourceSound::posMutex");
   ctx->sound = in_sound;
   ctx->sampleSize = sampleSize;
   ctx->numSamples = ga_sound_numSamples(in_sound);
@@ -0,0 +1,74 @@
+#include "gorilla/ga.h"
+#include "gorilla/gau.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Builds a sound bank from WAVE and Ogg/Vorbis files.
+ *
+ * Usage: soundbank <bank file> <name>=<sound file> [<name>=<sound file> ...]
+ *
+ * Each sound file is decoded once, and its PCM data is stored in the bank
+ * under the given name. The file's format is chosen by its extension.
+ */
+int main(int argc, char** argv)
+{
+  gc_int32 numSounds = argc - 2;
+  const char** names;
+  ga_Sound** sounds;
+  gc_int32 i;
+  gc_int32 ret = 0;
+
+  if(numSounds < 1)
+  {
+    fprintf(stderr, "usage: %s <bank file> <name>=<sound file> ...\n", argv[0]);
+    return 1;
+  }
+
+  gc_initialize(0);
+  names = (const char**)malloc(numSounds * sizeof(const char*));
+  sounds = (ga_Sound**)malloc(numSounds * sizeof(ga_Sound*));
+  memset(sounds, 0, numSounds * sizeof(ga_Sound*));
+
+  /* Decode each sound */
+  for(i = 0; i < numSounds && !ret; ++i)
+  {
+    char* arg = argv[i + 2];
+    char* filename = strchr(arg, '=');
+    char* ext;
+    if(!filename || filename == arg)
+    {
+      fprintf(stderr, "expected <name>=<sound file>: %s\n", arg);
+      ret = 1;
+      break;
+    }
+    *filename++ = 0;
+    names[i] = arg;
+    ext = strrchr(filename, '.');
+    sounds[i] = ext ? gau_load_sound_file(filename, ext + 1) : 0;
+    if(!sounds[i])
+    {
+      fprintf(stderr, "could not load sound file: %s\n", filename);
+      ret = 1;
+    }
+  }
+
+  /* Write the bank */
+  if(!ret && gau_sound_bank_write(argv[1], numSounds, names, sounds) != GC_SUCCESS)
+  {
+    fprintf(stderr, "could not write sound bank: %s\n", argv[1]);
+    ret = 1;
+  }
+
+  for(i = 0; i < numSounds; ++i)
+  {
+    if(sounds[i])
+      ga_sound_release(sounds[i]);
+  }
+  free(sounds);
+  free(names);
+  gc_shutdown();
+
+  return ret;
+}